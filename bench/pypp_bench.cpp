@@ -0,0 +1,798 @@
+#include "../pypp.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory_resource>
+#include <new>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/// @brief Number of calls to the global operator new, to report the allocations of a benchmark
+std::atomic<std::size_t> global_allocations { 0U };
+
+void* operator new(std::size_t size)
+{
+    global_allocations.fetch_add(1U, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size == 0U ? 1U : size))
+        return memory;
+
+    throw std::bad_alloc {};
+}
+
+// GCC pairs the inlined std::free() with new-expressions, although operator new above uses std::malloc()
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+#pragma GCC diagnostic pop
+
+namespace {
+
+/// @brief Prevent the compiler from optimizing away a computed value
+template <class T> void doNotOptimize(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/// @brief Wall time of a single call to @fn, in seconds
+template <class Fn> double secondsFor(Fn&& fn)
+{
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    const auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(stop - start).count();
+}
+
+/// @brief Counter::operator[] increment throughput as the number of distinct keys grows
+template <template <class, class> class Storage> void benchCounterIncrement(const char* storage_name)
+{
+    constexpr std::size_t increments { 2'000'000U };
+
+    for (const std::size_t distinct : { 10U, 1'000U, 100'000U, 1'000'000U }) {
+        collections::Counter<std::size_t, std::hash<std::size_t>, Storage> counter {};
+        const auto seconds = secondsFor([&]() {
+            for (std::size_t i = 0U; i < increments; ++i)
+                counter[(i * 2654435761U) % distinct] += 1;
+        });
+        doNotOptimize(counter.total());
+
+        std::printf("  %-5s distinct keys %9zu: %8.2f ns/increment\n", storage_name, distinct,
+            seconds * 1e9 / increments);
+    }
+}
+
+/// @brief ConcurrentCounter throughput on a shared-key workload, across thread counts
+void benchConcurrentCounter()
+{
+    constexpr std::size_t adds_per_thread { 2'000'000U };
+    constexpr std::size_t distinct { 1'000U };
+
+    for (const bool use_writer : { false, true }) {
+        const auto max_threads = std::max(1U, std::thread::hardware_concurrency());
+        for (unsigned n_threads = 1U; n_threads <= max_threads; n_threads *= 2U) {
+            collections::ConcurrentCounter<std::size_t> counter {};
+            const auto seconds = secondsFor([&]() {
+                std::vector<std::thread> threads {};
+                for (unsigned t = 0U; t < n_threads; ++t)
+                    threads.emplace_back([&, t]() {
+                        auto writer = counter.writer();
+                        for (std::size_t i = 0U; i < adds_per_thread; ++i) {
+                            const auto key = ((i + t) * 2654435761U) % distinct;
+                            if (use_writer)
+                                writer.add(key);
+                            else
+                                counter.add(key);
+                        }
+                    });
+                for (auto& thread : threads)
+                    thread.join();
+            });
+            doNotOptimize(counter.total());
+
+            std::printf("  %-6s threads %2u: %8.2f M adds/s\n", use_writer ? "writer" : "add", n_threads,
+                static_cast<double>(adds_per_thread * n_threads) / seconds / 1e6);
+        }
+    }
+}
+
+/// @brief Number of tokens of @s split on @delims, finding the end of each token with @find_first_of,
+///        as SplitRange does
+template <class FindFirstOf>
+std::size_t countTokens(std::string_view s, const pypp::Delimiters& delims, FindFirstOf find_first_of)
+{
+    std::size_t tokens { 0U };
+    for (std::size_t from = 0U;;) {
+        from = pypp::detail::findFirstNotOf(s, from, delims);
+        if (from == std::string_view::npos)
+            return tokens;
+        ++tokens;
+        from = std::min(find_first_of(s, from, delims), s.size());
+    }
+}
+
+/// @brief Splitting short comma-separated fields of many lines: scalar versus vector delimiter search
+void benchSplit()
+{
+    std::mt19937 rng { 5U };
+    std::uniform_int_distribution<int> pick_length { 1, 12 };
+    std::string buffer {};
+    while (buffer.size() < (64U << 20U)) {
+        for (int field = 0; field < 6; ++field)
+            buffer.append(static_cast<std::size_t>(pick_length(rng)), 'x').push_back(field < 5 ? ',' : '\n');
+    }
+    const pypp::Delimiters delims { ",\n" };
+
+    const auto report = [&](const char* name, auto&& count) {
+        std::size_t tokens { 0U };
+        const auto seconds = secondsFor([&]() { tokens = count(); });
+        doNotOptimize(tokens);
+        std::printf("  %-28s %8.2f GB/s (%zu tokens)\n", name,
+            static_cast<double>(buffer.size()) / seconds / 1e9, tokens);
+    };
+
+    report("findFirstOfScalar", [&]() {
+        return countTokens(buffer, delims, pypp::detail::findFirstOfScalar);
+    });
+    report("findFirstOfVector", [&]() {
+        return countTokens(buffer, delims, pypp::detail::findFirstOfVector);
+    });
+    report("splitRange", [&]() {
+        return static_cast<std::size_t>(std::ranges::distance(pypp::splitRange(buffer, delims)));
+    });
+}
+
+/// @brief Bulk counting of the characters of a large buffer, dense versus hashed storage
+void benchCounterBytes()
+{
+    std::string buffer(256U << 20U, '\0');
+    for (std::size_t i = 0U; i < buffer.size(); ++i)
+        buffer[i] = static_cast<char>('a' + (i * 2654435761U >> 7U) % 26U);
+
+    const auto report = [&](const char* storage_name, double seconds) {
+        std::printf("  %-18s %8.2f GB/s\n", storage_name, static_cast<double>(buffer.size()) / seconds / 1e9);
+    };
+
+    report("dense", secondsFor([&]() {
+        const collections::Counter<char> counter(buffer.begin(), buffer.end());
+        doNotOptimize(counter.total());
+    }));
+    report("dense, all threads", secondsFor([&]() {
+        const collections::Counter<char> counter(buffer.begin(), buffer.end(), 0U);
+        doNotOptimize(counter.total());
+    }));
+    report("node", secondsFor([&]() {
+        using NodeCounter = collections::Counter<char, std::hash<char>, collections::NodeStorage>;
+        const NodeCounter counter(buffer.begin(), buffer.end());
+        doNotOptimize(counter.total());
+    }));
+}
+
+/// @brief The former TupleHash: xor of the hashes of the first two elements
+struct XorTupleHash {
+    std::size_t operator()(const grid::Location& location) const noexcept
+    {
+        return std::hash<int> {}(location.first) ^ std::hash<int> {}(location.second);
+    }
+};
+
+/// @brief Insert then look up every location of a side x side grid
+template <class Set> void benchLocationSet(const char* name, int side)
+{
+    Set visited {};
+    const auto insert_seconds = secondsFor([&]() {
+        for (int x = 0; x < side; ++x)
+            for (int y = 0; y < side; ++y)
+                visited[{ x, y }] = 1;
+    });
+
+    std::size_t found { 0U };
+    const auto lookup_seconds = secondsFor([&]() {
+        for (int y = 0; y < side; ++y)
+            for (int x = 0; x < side; ++x)
+                found += visited.find({ x, y }) != nullptr;
+    });
+    doNotOptimize(found);
+
+    const auto cells = static_cast<double>(side) * side;
+    std::printf("  %-26s %4dx%-4d: insert %8.2f ns/cell, lookup %8.2f ns/cell\n", name, side, side,
+        insert_seconds * 1e9 / cells, lookup_seconds * 1e9 / cells);
+}
+
+/// @brief Adapt std::unordered_map to the find() -> pointer interface of FlatMap
+template <class Hash> struct NodeLocationSet {
+    std::unordered_map<grid::Location, int, Hash> map {};
+
+    int& operator[](const grid::Location& location)
+    {
+        return map[location];
+    }
+
+    const int* find(const grid::Location& location) const
+    {
+        const auto it = map.find(location);
+        return it == map.end() ? nullptr : &it->second;
+    }
+};
+
+/// @brief Location lookups with the former xor hash versus the mixed / packed TupleHash
+void benchTupleHash()
+{
+    // the xor hash maps a side x side grid to at most 2 * side buckets: keep it small
+    benchLocationSet<NodeLocationSet<XorTupleHash>>("unordered_map, xor hash", 600);
+    benchLocationSet<NodeLocationSet<collections::TupleHash>>("unordered_map, TupleHash", 600);
+    benchLocationSet<NodeLocationSet<collections::TupleHash>>("unordered_map, TupleHash", 2000);
+    benchLocationSet<collections::FlatMap<grid::Location, int, collections::TupleHash>>(
+        "FlatMap, TupleHash", 4000);
+}
+
+/// @brief Grid of open cells, with a wall every 7th cell of every 3rd row
+strings benchMaze(int side)
+{
+    strings maze(static_cast<std::size_t>(side), std::string(static_cast<std::size_t>(side), '.'));
+    for (int x = 2; x < side; x += 3)
+        for (int y = x % 7; y < side; y += 7)
+            maze[static_cast<std::size_t>(x)][static_cast<std::size_t>(y)] = '#';
+    return maze;
+}
+
+/// @brief Flood fill of a large grid: algorithms::dfs on strings versus GridSearch on grid::Grid
+void benchGridSearch()
+{
+    const auto is_open = [](char cell) { return cell == '.'; };
+    for (const int side : { 1000, 4000 }) {
+        const auto maze = benchMaze(side);
+        const auto cells = static_cast<double>(side) * side;
+
+        if (side <= 1000) {
+            std::unordered_set<grid::Location, collections::TupleHash> visited {};
+            std::size_t reached { 0U };
+            const auto seconds
+                = secondsFor([&]() { reached = algorithms::dfs(maze, { 0, 0 }, is_open, visited).size(); });
+            std::printf("  %-28s %4dx%-4d: %8.2f ns/cell (%zu cells)\n", "dfs, unordered_set", side, side,
+                seconds * 1e9 / cells, reached);
+        }
+
+        for (const bool bordered : { false, true }) {
+            const grid::Grid<char> grid(maze, bordered ? std::optional<char> { '#' } : std::nullopt);
+            algorithms::GridSearch<char> search(grid);
+            for (const auto mode : { algorithms::SearchMode::DFS, algorithms::SearchMode::BFS }) {
+                search.reset();
+                std::size_t reached { 0U };
+                const auto seconds = secondsFor([&]() {
+                    reached = search.search({ 0, 0 }, is_open, mode, [](const grid::Location&, int) { });
+                });
+                const auto* name = mode == algorithms::SearchMode::DFS
+                    ? (bordered ? "GridSearch DFS, border" : "GridSearch DFS")
+                    : (bordered ? "GridSearch BFS, border" : "GridSearch BFS");
+                std::printf("  %-28s %4dx%-4d: %8.2f ns/cell (%zu cells)\n", name, side, side,
+                    seconds * 1e9 / cells, reached);
+            }
+        }
+    }
+}
+
+/// @brief Label every region of a grid: repeated GridSearch versus labelComponents over thread counts
+void benchLabelComponents()
+{
+    const auto is_open = [](char cell) { return cell == '.'; };
+    const int side { 4000 };
+    std::mt19937 rng { 3U };
+    std::bernoulli_distribution is_wall { 0.4 };
+    strings maze(side, std::string(side, '.'));
+    for (auto& line : maze)
+        for (auto& cell : line)
+            cell = is_wall(rng) ? '#' : '.';
+    const grid::Grid<char> grid(maze);
+    const auto cells = static_cast<double>(side) * side;
+
+    algorithms::GridSearch<char> search(grid);
+    std::size_t components { 0U };
+    const auto serial_seconds = secondsFor([&]() {
+        for (int x = 0; x < side; ++x)
+            for (int y = 0; y < side; ++y)
+                components += search.search({ x, y }, is_open, algorithms::SearchMode::DFS,
+                                  [](const grid::Location&, int) { })
+                    > 0U;
+    });
+    std::printf("  %-28s %4dx%-4d: %8.2f ns/cell (%zu components)\n", "repeated GridSearch", side, side,
+        serial_seconds * 1e9 / cells, components);
+
+    for (const unsigned threads : { 1U, 2U, 4U, 8U }) {
+        algorithms::ComponentLabels result {};
+        const auto seconds
+            = secondsFor([&]() { result = algorithms::labelComponents(grid, is_open, threads); });
+        std::printf("  labelComponents, %u thread(s) %4dx%-4d: %8.2f ns/cell (%zu components, x%.2f)\n",
+            threads, side, side, seconds * 1e9 / cells, result.sizes.size(), serial_seconds / seconds);
+    }
+}
+
+/// @brief Dijkstra over a grid of random digits: std::priority_queue and hash maps versus GridPaths
+void benchGridPaths()
+{
+    std::mt19937 rng { 9U };
+    std::uniform_int_distribution<int> pick_digit { 1, 9 };
+    const auto digitGrid = [&](int side) {
+        strings digits(side, std::string(side, '1'));
+        for (auto& line : digits)
+            for (auto& cell : line)
+                cell = static_cast<char>('0' + pick_digit(rng));
+        return grid::Grid<char>(digits);
+    };
+    const auto cost
+        = [](const algorithms::GridState&, const algorithms::GridState&, char cell) { return cell - '0'; };
+    const auto never = [](const algorithms::GridState&) { return false; };
+
+    {
+        const int side { 1000 };
+        const auto grid = digitGrid(side);
+        int distance { 0 };
+        const auto seconds = secondsFor([&]() {
+            using Node = std::pair<int, grid::Location>;
+            std::priority_queue<Node, std::vector<Node>, std::greater<>> queue {};
+            std::unordered_map<grid::Location, int, collections::TupleHash> distances {};
+            distances[{ 0, 0 }] = 0;
+            queue.push({ 0, { 0, 0 } });
+            while (!queue.empty()) {
+                const auto [d, location] = queue.top();
+                queue.pop();
+                if (d > distances[location])
+                    continue;
+                for (auto [dx, dy] : grid::move()) {
+                    const grid::Location next { location.first + dx, location.second + dy };
+                    if (!grid.inBounds(next))
+                        continue;
+                    const auto nd = d + (grid[next] - '0');
+                    const auto it = distances.find(next);
+                    if (it == distances.end() || nd < it->second) {
+                        distances[next] = nd;
+                        queue.push({ nd, next });
+                    }
+                }
+            }
+            distance = distances[{ side - 1, side - 1 }];
+        });
+        std::printf("  %-36s %8.3f s for %d states (distance %d)\n", "priority_queue + unordered_map",
+            seconds, side * side, distance);
+    }
+
+    for (const bool directional : { false, true }) {
+        const int side = directional ? 2000 : 4000;
+        const auto grid = digitGrid(side);
+        algorithms::GridPaths<char> paths(grid, directional);
+        int distance { 0 };
+        const auto seconds = secondsFor([&]() {
+            paths.run({ { 0, 0 } }, cost, never);
+            distance = paths.distance({ { side - 1, side - 1 }, grid::Direction::DOWN });
+        });
+        std::printf("  %-36s %8.3f s for %d states (distance %d)\n",
+            directional ? "GridPaths, directional" : "GridPaths", seconds,
+            side * side * (directional ? 4 : 1), distance);
+    }
+}
+
+/// @brief Pack a {x, y, keys} state into a single 64-bit key
+struct PackedKeyState {
+    using key_type = std::uint64_t;
+
+    static std::uint64_t encode(const std::tuple<int, int, int>& state)
+    {
+        const auto [x, y, keys] = state;
+        return (static_cast<std::uint64_t>(x) << 40U) | (static_cast<std::uint64_t>(y) << 16U)
+            | static_cast<std::uint64_t>(keys);
+    }
+
+    static std::tuple<int, int, int> decode(std::uint64_t key)
+    {
+        return { static_cast<int>(key >> 40U), static_cast<int>((key >> 16U) & 0xffffffU),
+            static_cast<int>(key & 0xffffU) };
+    }
+};
+
+/// @brief BFS over {x, y, keys} states of an open grid with 4 keys:
+///        std::queue and unordered_set versus StateSearch, with and without a packed codec
+void benchStateSearch()
+{
+    using State = std::tuple<int, int, int>;
+    const int side { 300 };
+    const std::array<std::pair<grid::Location, int>, 4U> keys {
+        { { { 7, 250 }, 1 }, { { 250, 9 }, 2 }, { { 150, 150 }, 4 }, { { 299, 0 }, 8 } }
+    };
+    const auto keyAt = [&](int x, int y) {
+        for (const auto& [location, key] : keys)
+            if (location == grid::Location { x, y })
+                return key;
+        return 0;
+    };
+    const auto neighbors = [&](const State& state, auto&& emit) {
+        const auto [x, y, keys] = state;
+        for (auto [dx, dy] : grid::move()) {
+            const auto nx = x + dx;
+            const auto ny = y + dy;
+            if (0 <= nx && nx < side && 0 <= ny && ny < side)
+                emit(State { nx, ny, keys | keyAt(nx, ny) });
+        }
+    };
+    const auto never = [](const State&) { return false; };
+
+    std::size_t reached { 0U };
+    const auto node_seconds = secondsFor([&]() {
+        std::unordered_set<State, collections::TupleHash> visited { { 0, 0, 0 } };
+        std::queue<State> queue {};
+        queue.push({ 0, 0, 0 });
+        while (!queue.empty()) {
+            const auto state = queue.front();
+            queue.pop();
+            neighbors(state, [&](const State& next) {
+                if (visited.insert(next).second)
+                    queue.push(next);
+            });
+        }
+        reached = visited.size();
+    });
+    std::printf("  %-32s %8.3f s for %zu states\n", "queue + unordered_set", node_seconds, reached);
+
+    algorithms::StateSearch<State> search {};
+    const auto store_seconds = secondsFor([&]() { search.bfs(State { 0, 0, 0 }, neighbors, never); });
+    std::printf("  %-32s %8.3f s for %zu states\n", "StateSearch", store_seconds, search.states().size());
+
+    algorithms::StateSearch<State, PackedKeyState> packed_search {};
+    const auto packed_seconds = secondsFor([&]() { packed_search.bfs(State { 0, 0, 0 }, neighbors, never); });
+    std::printf("  %-32s %8.3f s for %zu states\n", "StateSearch, packed", packed_seconds,
+        packed_search.states().size());
+}
+
+/// @brief Sum the products of three columns of a table: materializing iterator zip versus lazy zip
+void benchZip()
+{
+    const std::size_t rows { 10'000'000U };
+    std::vector<int> ids(rows);
+    std::vector<double> prices(rows);
+    std::vector<std::string> names(rows, "name");
+    std::iota(ids.begin(), ids.end(), 0);
+    std::iota(prices.begin(), prices.end(), 0.5);
+
+    double total { 0.0 };
+    const auto copy_seconds = secondsFor([&]() {
+        for (const auto& [id, price, name] : pypp::zip(ids.begin(), ids.end(), prices.begin(), names.begin()))
+            total += id * price + static_cast<double>(name.size());
+    });
+    doNotOptimize(total);
+    std::printf("  %-28s %8.3f s for %zu rows\n", "zip(iterators), copying", copy_seconds, rows);
+
+    total = 0.0;
+    const auto lazy_seconds = secondsFor([&]() {
+        for (const auto& [id, price, name] : pypp::zip(ids, prices, names))
+            total += id * price + static_cast<double>(name.size());
+    });
+    doNotOptimize(total);
+    std::printf("  %-28s %8.3f s for %zu rows\n", "zip(ranges), lazy", lazy_seconds, rows);
+}
+
+/// @brief Visit every 3-combination of 600 elements: materialized vector, lazy view, lazy view across threads
+void benchCombinations()
+{
+    std::vector<int> numbers(600);
+    std::iota(numbers.begin(), numbers.end(), 1);
+    const auto triples = itertools::combinations<3>(numbers);
+
+    std::int64_t total { 0 };
+    const auto materialized_seconds = secondsFor([&]() {
+        std::vector<std::tuple<int, int, int>> all {};
+        for (std::size_t a = 0U; a < numbers.size(); ++a)
+            for (auto b = a + 1U; b < numbers.size(); ++b)
+                for (auto c = b + 1U; c < numbers.size(); ++c)
+                    all.emplace_back(numbers[a], numbers[b], numbers[c]);
+        for (const auto& [a, b, c] : all)
+            total += (a ^ b) + c;
+    });
+    doNotOptimize(total);
+    std::printf(
+        "  %-34s %8.3f s for %zu triples\n", "vector of tuples", materialized_seconds, triples.size());
+
+    total = 0;
+    const auto lazy_seconds = secondsFor([&]() {
+        for (const auto& [a, b, c] : triples)
+            total += (a ^ b) + c;
+    });
+    doNotOptimize(total);
+    std::printf("  %-34s %8.3f s for %zu triples\n", "combinations<3>", lazy_seconds, triples.size());
+
+    for (const unsigned threads : { 2U, 4U }) {
+        std::atomic<std::int64_t> parallel_total { 0 };
+        const auto parallel_seconds = secondsFor([&]() {
+            pypp::detail::parallelFor(threads, threads, [&](std::size_t part) {
+                std::int64_t part_total { 0 };
+                for (const auto& [a, b, c] : itertools::partition(triples, part, threads))
+                    part_total += (a ^ b) + c;
+                parallel_total += part_total;
+            });
+        });
+        std::printf("  combinations<3>, %u partitions %10.3f s for %zu triples\n", threads, parallel_seconds,
+            triples.size());
+    }
+}
+
+/// @brief Integers of 1M lines such as "p=12,-7 v=-3,95": split + std::stoi versus extractInts / parseInts
+void benchParseInts()
+{
+    std::mt19937 rng { 5U };
+    std::uniform_int_distribution<int> pick { -999, 999 };
+    std::string buffer {};
+    for (int line = 0; line < 1'000'000; ++line)
+        buffer += "p=" + std::to_string(pick(rng)) + "," + std::to_string(pick(rng)) + " v="
+            + std::to_string(pick(rng)) + "," + std::to_string(pick(rng)) + "\n";
+
+    long long total { 0 };
+    const auto stoi_seconds = secondsFor([&]() {
+        for (const auto& line : pypp::splitLines(buffer))
+            for (const auto& token : pypp::split(line, " ,"))
+                total += std::stoi(token.substr(token.find('=') + 1U));
+    });
+    doNotOptimize(total);
+    std::printf("  %-30s %8.3f s (%6.1f MB/s)\n", "splitLines + split + stoi", stoi_seconds,
+        static_cast<double>(buffer.size()) / stoi_seconds / 1e6);
+
+    total = 0;
+    const auto extract_seconds = secondsFor([&]() {
+        for (const auto line : pypp::LineRange(buffer))
+            pypp::forEachInt<int>(line, [&](int value) { total += value; });
+    });
+    doNotOptimize(total);
+    std::printf("  %-30s %8.3f s (%6.1f MB/s)\n", "LineRange + forEachInt", extract_seconds,
+        static_cast<double>(buffer.size()) / extract_seconds / 1e6);
+
+    pypp::IntRows<int> rows {};
+    const auto parse_seconds = secondsFor([&]() { rows = pypp::parseInts(buffer); });
+    doNotOptimize(rows.values.size());
+    std::printf("  %-30s %8.3f s (%6.1f MB/s)\n", "parseInts", parse_seconds,
+        static_cast<double>(buffer.size()) / parse_seconds / 1e6);
+}
+
+/// @brief 1M lines such as "move 12 from 3 to 7": split + std::stoi versus scan() / scanLines()
+void benchScan()
+{
+    std::mt19937 rng { 6U };
+    std::uniform_int_distribution<int> pick { 1, 50 };
+    std::string buffer {};
+    for (int line = 0; line < 1'000'000; ++line)
+        buffer += "move " + std::to_string(pick(rng)) + " from " + std::to_string(pick(rng) % 9 + 1) + " to "
+            + std::to_string(pick(rng) % 9 + 1) + "\n";
+
+    long long total { 0 };
+    const auto split_seconds = secondsFor([&]() {
+        for (const auto& line : pypp::splitLines(buffer)) {
+            const auto tokens = pypp::split(line, ' ');
+            total += std::stoi(tokens[1]) + std::stoi(tokens[3]) + std::stoi(tokens[5]);
+        }
+    });
+    doNotOptimize(total);
+    std::printf("  %-30s %8.3f s (%6.1f MB/s)\n", "splitLines + split + stoi", split_seconds,
+        static_cast<double>(buffer.size()) / split_seconds / 1e6);
+
+    total = 0;
+    const auto scan_seconds = secondsFor([&]() {
+        for (const auto line : pypp::LineRange(buffer))
+            if (const auto move = pypp::scan<"move {} from {} to {}", int, int, int>(line))
+                total += std::get<0>(*move) + std::get<1>(*move) + std::get<2>(*move);
+    });
+    doNotOptimize(total);
+    std::printf("  %-30s %8.3f s (%6.1f MB/s)\n", "LineRange + scan", scan_seconds,
+        static_cast<double>(buffer.size()) / scan_seconds / 1e6);
+
+    pypp::ScanColumns<int, int, int> moves {};
+    const auto columns_seconds
+        = secondsFor([&]() { moves = pypp::scanLines<"move {} from {} to {}", int, int, int>(buffer); });
+    doNotOptimize(moves.size());
+    std::printf("  %-30s %8.3f s (%6.1f MB/s)\n", "scanLines", columns_seconds,
+        static_cast<double>(buffer.size()) / columns_seconds / 1e6);
+}
+
+/// @brief Per-request parsing of a small CSV-like text: default allocator versus an Arena reset per request
+void benchArena()
+{
+    constexpr std::size_t requests { 100'000U };
+    std::string request {};
+    for (int line = 0; line < 16; ++line)
+        for (int field = 0; field < 6; ++field)
+            request += "field_" + std::to_string(line) + "_" + std::to_string(field) + "_with_payload"
+                + (field == 5 ? "\n" : ",");
+
+    const auto report = [&](const char* name, auto&& parse) {
+        std::size_t total { 0U };
+        const auto allocations = global_allocations.load();
+        const auto seconds = secondsFor([&]() {
+            for (std::size_t i = 0U; i < requests; ++i)
+                total += parse();
+        });
+        doNotOptimize(total);
+        std::printf("  %-34s %8.3f s %10zu allocations\n", name, seconds,
+            global_allocations.load() - allocations);
+    };
+
+    report("splitLines + split", [&]() {
+        std::size_t size { 0U };
+        for (const auto& line : pypp::splitLines(request))
+            for (const auto& token : pypp::split(line, ','))
+                size += token.size();
+        return size;
+    });
+
+    pypp::Arena arena {};
+    report("splitLines + split, Arena", [&]() {
+        std::size_t size { 0U };
+        for (const auto& line : pypp::splitLines(request, arena))
+            for (const auto& token : pypp::split(line, ',', arena))
+                size += token.size();
+        arena.reset();
+        return size;
+    });
+
+    report("splitLinesView + splitView, Arena", [&]() {
+        std::size_t size { 0U };
+        for (const auto line : pypp::splitLinesView(request, arena))
+            for (const auto token : pypp::splitView(line, ',', arena))
+                size += token.size();
+        arena.reset();
+        return size;
+    });
+}
+
+/// @brief Word counts of a 2M-word text: split + Counter<std::string> versus splitIds + IdCounter
+void benchInterner()
+{
+    std::mt19937 rng { 7U };
+    std::uniform_int_distribution<int> pick { 0, 9'999 };
+    std::string text {};
+    for (int word = 0; word < 2'000'000; ++word)
+        text += "word_" + std::to_string(pick(rng)) + (word % 16 == 15 ? "\n" : " ");
+
+    std::size_t distinct { 0U };
+    const auto string_seconds = secondsFor([&]() {
+        const auto words = pypp::split(text, " \n");
+        const collections::Counter<std::string> counts(words.begin(), words.end());
+        distinct = counts.size();
+    });
+    doNotOptimize(distinct);
+    std::printf("  %-34s %8.3f s (%zu distinct)\n", "split + Counter<std::string>", string_seconds, distinct);
+
+    using ViewCounter
+        = collections::Counter<std::string_view, std::hash<std::string_view>, collections::FlatStorage>;
+    const auto view_seconds = secondsFor([&]() {
+        ViewCounter counts {};
+        for (const auto word : pypp::splitRange(text, " \n"))
+            counts[word] += 1;
+        distinct = counts.size();
+    });
+    doNotOptimize(distinct);
+    std::printf("  %-34s %8.3f s (%zu distinct)\n", "splitRange + flat view Counter", view_seconds, distinct);
+
+    pypp::Interner interner {};
+    const auto id_seconds = secondsFor([&]() {
+        const auto ids = pypp::splitIds(text, " \n", interner);
+        const collections::IdCounter counts(ids.begin(), ids.end());
+        distinct = counts.size();
+    });
+    doNotOptimize(distinct);
+    std::printf("  %-34s %8.3f s (%zu distinct, pool of %zu bytes)\n", "splitIds + IdCounter", id_seconds,
+        distinct, interner.pool().size());
+}
+
+/// @brief Recursive lattice-path DP over 400 x 400 states: hand-rolled unordered_map memo versus memoize,
+///        then lruCache hit rates on skewed queries
+void benchMemoize()
+{
+    constexpr int side { 400 };
+    constexpr std::uint64_t modulo { 1'000'000'007U };
+
+    std::unordered_map<grid::Location, std::uint64_t, XorTupleHash> memo {};
+    const auto paths = [&](const auto& self, int rows, int cols) -> std::uint64_t {
+        if (rows == 0 || cols == 0)
+            return 1U;
+        if (const auto found = memo.find({ rows, cols }); found != memo.end())
+            return found->second;
+        const auto result = (self(self, rows - 1, cols) + self(self, rows, cols - 1)) % modulo;
+        memo.emplace(grid::Location { rows, cols }, result);
+        return result;
+    };
+    std::uint64_t total { 0U };
+    const auto map_seconds = secondsFor([&]() { total = paths(paths, side, side); });
+    doNotOptimize(total);
+    std::printf("  %-36s %8.3f s\n", "unordered_map memo, xor hash", map_seconds);
+
+    const auto step = [&](auto& self, int rows, int cols) -> std::uint64_t {
+        return rows == 0 || cols == 0 ? 1U : (self(rows - 1, cols) + self(rows, cols - 1)) % modulo;
+    };
+    auto cached = pypp::memoize<std::uint64_t(int, int)>(step);
+    const auto memoize_seconds = secondsFor([&]() { total = cached(side, side); });
+    doNotOptimize(total);
+    std::printf("  %-36s %8.3f s (%zu misses, %zu hits)\n", "memoize", memoize_seconds,
+        cached.cacheInfo().misses, cached.cacheInfo().hits);
+
+    // expensive function of keys drawn from a geometric distribution
+    std::mt19937 rng { 8U };
+    std::geometric_distribution<int> pick { 0.001 };
+    std::vector<int> queries(1'000'000U);
+    for (auto& query : queries)
+        query = pick(rng);
+    const auto work = [](int key) {
+        std::uint64_t hash { static_cast<std::uint64_t>(key) };
+        for (int round = 0; round < 200; ++round)
+            hash = collections::detail::mix64(hash);
+        return hash;
+    };
+
+    const auto uncached_seconds = secondsFor([&]() {
+        for (const auto query : queries)
+            total += work(query);
+    });
+    doNotOptimize(total);
+    std::printf("  %-36s %8.3f s\n", "uncached", uncached_seconds);
+
+    auto lru = pypp::lruCache<1024U, std::uint64_t(int)>(work);
+    const auto lru_seconds = secondsFor([&]() {
+        for (const auto query : queries)
+            total += lru(query);
+    });
+    doNotOptimize(total);
+    const auto info = lru.cacheInfo();
+    std::printf("  %-36s %8.3f s (hit rate %.1f %%)\n", "lruCache<1024>", lru_seconds,
+        100.0 * static_cast<double>(info.hits) / static_cast<double>(info.hits + info.misses));
+}
+
+const std::vector<std::pair<std::string, std::function<void()>>> benchmarks {
+    { "counter_increment",
+        []() {
+            benchCounterIncrement<collections::NodeStorage>("node");
+            benchCounterIncrement<collections::FlatStorage>("flat");
+        } },
+    { "concurrent_counter", benchConcurrentCounter },
+    { "counter_bytes", benchCounterBytes },
+    { "split", benchSplit },
+    { "tuple_hash", benchTupleHash },
+    { "grid_search", benchGridSearch },
+    { "label_components", benchLabelComponents },
+    { "grid_paths", benchGridPaths },
+    { "state_search", benchStateSearch },
+    { "zip", benchZip },
+    { "combinations", benchCombinations },
+    { "parse_ints", benchParseInts },
+    { "scan", benchScan },
+    { "arena", benchArena },
+    { "interner", benchInterner },
+    { "memoize", benchMemoize },
+};
+
+} // namespace
+
+/// Usage: pypp_bench [name-filter]
+int main(int argc, char** argv)
+{
+    const std::string filter { argc > 1 ? argv[1] : "" };
+
+    for (const auto& [name, run] : benchmarks) {
+        if (name.find(filter) == std::string::npos)
+            continue;
+        std::printf("%s\n", name.c_str());
+        run();
+    }
+
+    return 0;
+}
@@ -3,72 +3,398 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <concepts>
 #include <cstdint>
+#include <exception>
 #include <fstream>
+#include <functional>
 #include <iostream>
-#include <set>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <shared_mutex>
+#include <span>
 #include <stack>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#if !defined(PYPP_NO_SIMD) && (defined(__AVX2__) || defined(__SSE2__))
+#include <immintrin.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 using strings = std::vector<std::string>;
 
 namespace pypp {
 
+/// @brief Containers allocating from a std::pmr::memory_resource, e.g. an Arena
+namespace pmr {
+
+    using strings = std::pmr::vector<std::pmr::string>;
+    using string_views = std::pmr::vector<std::string_view>;
+
+} // namespace pmr
+
+/// @brief Monotonic memory resource for parse-then-discard workloads: allocations are carved out of
+///        blocks that double in size, deallocation does nothing, and reset() recycles everything at once
+///
+/// @note Not thread-safe: use one arena per thread
+class Arena : public std::pmr::memory_resource {
+public:
+    /// @param block_size size of the first block
+    /// @param upstream resource the blocks are allocated from
+    explicit Arena(std::size_t block_size = 1U << 16U,
+        std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : next_block_size_ { std::max(block_size, 4U * sizeof(Block)) }
+        , upstream_ { upstream }
+    {
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    ~Arena() override
+    {
+        release();
+    }
+
+    /// @brief Make all the memory available again, keeping only the last (and largest) block
+    /// @note Everything allocated from the arena must be dead
+    void reset()
+    {
+        if (blocks_ == nullptr)
+            return;
+
+        freeBlocks(blocks_->next);
+        blocks_->next = nullptr;
+        use(blocks_);
+        used_ = 0U;
+    }
+
+    /// @brief Return every block to the upstream resource
+    void release()
+    {
+        freeBlocks(blocks_);
+        blocks_ = nullptr;
+        cursor_ = nullptr;
+        end_ = nullptr;
+        used_ = 0U;
+    }
+
+    /// @return bytes handed out since construction or the last reset()
+    std::size_t used() const
+    {
+        return used_;
+    }
+
+    /// @return bytes held from the upstream resource
+    std::size_t capacity() const
+    {
+        return capacity_;
+    }
+
+private:
+    struct Block {
+        Block* next { nullptr };
+        std::size_t size { 0U };
+    };
+
+    static constexpr std::size_t block_alignment { alignof(std::max_align_t) };
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        void* first = cursor_;
+        auto space = static_cast<std::size_t>(end_ - cursor_);
+        if (std::align(alignment, bytes, first, space) == nullptr) {
+            grow(bytes + alignment);
+            first = cursor_;
+            space = static_cast<std::size_t>(end_ - cursor_);
+            std::align(alignment, bytes, first, space);
+        }
+
+        cursor_ = static_cast<std::byte*>(first) + bytes;
+        used_ += bytes;
+        return first;
+    }
+
+    void do_deallocate(void*, std::size_t, std::size_t) override { }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    void grow(std::size_t bytes)
+    {
+        const auto size = std::max(next_block_size_, bytes + sizeof(Block));
+        auto* block = new (upstream_->allocate(size, block_alignment)) Block { blocks_, size };
+        blocks_ = block;
+        capacity_ += size;
+        next_block_size_ = 2U * size;
+        use(block);
+    }
+
+    void use(Block* block)
+    {
+        cursor_ = reinterpret_cast<std::byte*>(block) + sizeof(Block);
+        end_ = reinterpret_cast<std::byte*>(block) + block->size;
+    }
+
+    void freeBlocks(Block* block)
+    {
+        while (block != nullptr) {
+            auto* const next = block->next;
+            capacity_ -= block->size;
+            upstream_->deallocate(block, block->size, block_alignment);
+            block = next;
+        }
+    }
+
+    std::size_t next_block_size_ {};
+    std::pmr::memory_resource* upstream_ {};
+    Block* blocks_ { nullptr };
+    std::byte* cursor_ { nullptr };
+    std::byte* end_ { nullptr };
+    std::size_t used_ { 0U };
+    std::size_t capacity_ { 0U };
+};
+
+/// @brief A set of characters backed by a 256-entry lookup table,
+///        usable as a predicate in place of the locale-dependent std::isdigit, std::isalpha...
+class CharClass {
+public:
+    constexpr CharClass() = default;
+
+    /// @param chars the characters belonging to the class
+    constexpr explicit CharClass(std::string_view chars)
+    {
+        for (const char c : chars)
+            table_[static_cast<unsigned char>(c)] = true;
+    }
+
+    /// @return the class of all characters in [@first, @last]
+    static constexpr CharClass range(char first, char last)
+    {
+        CharClass result {};
+        // int counter: an unsigned char one would wrap around and never exceed a @last of '\xff'
+        for (int c = static_cast<unsigned char>(first); c <= static_cast<unsigned char>(last); ++c)
+            result.table_[static_cast<std::size_t>(c)] = true;
+        return result;
+    }
+
+    constexpr bool operator()(unsigned char c) const
+    {
+        return table_[c];
+    }
+
+    constexpr CharClass operator|(const CharClass& other) const
+    {
+        CharClass result {};
+        for (std::size_t c = 0U; c < table_.size(); ++c)
+            result.table_[c] = table_[c] || other.table_[c];
+        return result;
+    }
+
+    constexpr CharClass operator~() const
+    {
+        CharClass result {};
+        for (std::size_t c = 0U; c < table_.size(); ++c)
+            result.table_[c] = !table_[c];
+        return result;
+    }
+
+private:
+    std::array<bool, 256U> table_ {};
+};
+
+/// @brief Character classes of the "C" locale
+namespace chars {
+
+    inline constexpr CharClass digit { CharClass::range('0', '9') };
+    inline constexpr CharClass alpha { CharClass::range('a', 'z') | CharClass::range('A', 'Z') };
+    inline constexpr CharClass alnum { digit | alpha };
+    inline constexpr CharClass space { " \t\n\v\f\r" };
+
+} // namespace chars
+
+/// @brief Exactly std::string_view, so that std::string and const char* keep selecting
+///        the copying overloads
+template <typename T>
+concept StringView = std::same_as<T, std::string_view>;
+
+/// @brief Remove leading characters from the string, in place, if predicate holds true
+///
+/// @tparam p predicate that determines which characters shall be removed
+/// @param s a string
+template <typename UnaryPredicate> constexpr void lstripInPlace(std::string& s, UnaryPredicate p)
+{
+    s.erase(s.begin(), std::find_if_not(s.begin(), s.end(), p));
+}
+
+/// @brief Remove trailing characters from the string, in place, if predicate holds true
+///
+/// @tparam p predicate that determines which characters shall be removed
+/// @param s a string
+template <typename UnaryPredicate> constexpr void rstripInPlace(std::string& s, UnaryPredicate p)
+{
+    s.erase(std::find_if_not(s.rbegin(), s.rend(), p).base(), s.end());
+}
+
+/// @brief Remove leading and trailing characters from the string, in place, if predicate holds true
+///
+/// @tparam p predicate that determines which characters shall be removed
+/// @param s a string
+template <typename UnaryPredicate> constexpr void stripInPlace(std::string& s, UnaryPredicate p)
+{
+    rstripInPlace(s, p);
+    lstripInPlace(s, p);
+}
+
+/// @brief Return a view of the string without its leading characters for which predicate holds true
+///
+/// @tparam p predicate that determines which characters shall be removed
+/// @param s a string view
+/// @return a view into @s with leading characters removed if @p holds true
+template <StringView View, typename UnaryPredicate>
+constexpr std::string_view lstrip(View s, UnaryPredicate p)
+{
+    s.remove_prefix(static_cast<std::size_t>(std::find_if_not(s.begin(), s.end(), p) - s.begin()));
+    return s;
+}
+
+/// @brief Return a view of the string without its trailing characters for which predicate holds true
+///
+/// @tparam p predicate that determines which characters shall be removed
+/// @param s a string view
+/// @return a view into @s with trailing characters removed if @p holds true
+template <StringView View, typename UnaryPredicate>
+constexpr std::string_view rstrip(View s, UnaryPredicate p)
+{
+    s.remove_suffix(static_cast<std::size_t>(std::find_if_not(s.rbegin(), s.rend(), p) - s.rbegin()));
+    return s;
+}
+
+/// @brief Return a view of the string without its leading and trailing characters
+///        for which predicate holds true
+///
+/// @tparam p predicate that determines which characters shall be removed
+/// @param s a string view
+/// @return a view into @s with leading and trailing characters removed if @p holds true
+template <StringView View, typename UnaryPredicate>
+constexpr std::string_view strip(View s, UnaryPredicate p)
+{
+    return lstrip(rstrip(s, p), p);
+}
+
 /// @brief Return a copy of the string with leading digit characters removed
 ///
 /// @param s a string
 /// @return a copy of @s with leading digits removed
-std::string lstripDigit(std::string s)
+constexpr std::string lstripDigit(std::string s)
 {
-    s.erase(s.begin(), std::find_if(s.begin(), s.end(), [](unsigned char c) { return !std::isdigit(c); }));
+    lstripInPlace(s, chars::digit);
     return s;
 }
 
+/// @brief Return a view of the string without its leading digit characters
+///
+/// @param s a string view
+/// @return a view into @s with leading digits removed
+template <StringView View> constexpr std::string_view lstripDigit(View s)
+{
+    return lstrip(s, chars::digit);
+}
+
 /// @brief Return a copy of the string with trailing digit characters removed
 ///
 /// @param s a string
 /// @return a copy of @s with trailing digits removed
-std::string rstripDigit(std::string s)
+constexpr std::string rstripDigit(std::string s)
 {
-    s.erase(
-        std::find_if(s.rbegin(), s.rend(), [](unsigned char c) { return !std::isdigit(c); }).base(), s.end());
+    rstripInPlace(s, chars::digit);
     return s;
 }
 
+/// @brief Return a view of the string without its trailing digit characters
+///
+/// @param s a string view
+/// @return a view into @s with trailing digits removed
+template <StringView View> constexpr std::string_view rstripDigit(View s)
+{
+    return rstrip(s, chars::digit);
+}
+
 /// @brief Return a copy of the string with leading alphabetical characters removed
 ///
 /// @param s a string
 /// @return a copy of @s with leading alphas removed
-std::string lstripAlpha(std::string s)
+constexpr std::string lstripAlpha(std::string s)
 {
-    s.erase(s.begin(), std::find_if(s.begin(), s.end(), [](unsigned char c) { return !std::isalpha(c); }));
+    lstripInPlace(s, chars::alpha);
     return s;
 }
 
+/// @brief Return a view of the string without its leading alphabetical characters
+///
+/// @param s a string view
+/// @return a view into @s with leading alphas removed
+template <StringView View> constexpr std::string_view lstripAlpha(View s)
+{
+    return lstrip(s, chars::alpha);
+}
+
 /// @brief Return a copy of the string with trailing alphabetical characters removed
 ///
 /// @param s a string
 /// @return a copy of @s with trailing alphas removed
-std::string rstripAlpha(std::string s)
+constexpr std::string rstripAlpha(std::string s)
 {
-    s.erase(
-        std::find_if(s.rbegin(), s.rend(), [](unsigned char c) { return !std::isalpha(c); }).base(), s.end());
+    rstripInPlace(s, chars::alpha);
     return s;
 }
 
+/// @brief Return a view of the string without its trailing alphabetical characters
+///
+/// @param s a string view
+/// @return a view into @s with trailing alphas removed
+template <StringView View> constexpr std::string_view rstripAlpha(View s)
+{
+    return rstrip(s, chars::alpha);
+}
+
 /// @brief Return a copy of the string with leading characters removed
 ///        if predicate holds true
 ///
 /// @tparam p predicate that determines which characters shall be removed
 /// @param s a string
 /// @return a copy of @s with leading characters removed if @p holds true
-template <typename UnaryPredicate> std::string lstrip(std::string s, UnaryPredicate p)
+template <typename UnaryPredicate> constexpr std::string lstrip(std::string s, UnaryPredicate p)
 {
-    s.erase(s.begin(), std::find_if_not(s.begin(), s.end(), p));
+    lstripInPlace(s, p);
     return s;
 }
 
@@ -78,9 +404,9 @@ template <typename UnaryPredicate> std::string lstrip(std::string s, UnaryPredic
 /// @tparam p predicate that determines which characters shall be removed
 /// @param s a string
 /// @return a copy of @s with trailing characters removed if @p holds true
-template <typename UnaryPredicate> std::string rstrip(std::string s, UnaryPredicate p)
+template <typename UnaryPredicate> constexpr std::string rstrip(std::string s, UnaryPredicate p)
 {
-    s.erase(std::find_if_not(s.rbegin(), s.rend(), p).base(), s.end());
+    rstripInPlace(s, p);
     return s;
 }
 
@@ -90,424 +416,5421 @@ template <typename UnaryPredicate> std::string rstrip(std::string s, UnaryPredic
 /// @tparam p predicate that determines which characters shall be removed
 /// @param s a string
 /// @return a copy of @s with leading and trailing characters removed if @p holds true
-template <typename UnaryPredicate> std::string strip(std::string s, UnaryPredicate p)
-{
-    return lstrip(rstrip(s, p), p);
-}
-
-///@brief Split a string into a vector of strings
-///
-/// @param  input_s string to split
-/// @param  split_on character by which to split the string
-/// @param  at_most number of (sub)strings generated
-/// @return a vector of substrings obtained by splitting @input_s every @split_on
-strings split(const std::string& input_s, char split_on, int at_most = -1)
-{
-    strings result {};
-    std::string buffer {};
-    buffer.reserve(input_s.size());
-
-    if (input_s.empty())
-        return result;
-
-    for (const char ch : input_s) {
-        if (ch != split_on)
-            buffer.push_back(ch);
-        else if (!buffer.empty()) {
-            result.push_back(buffer);
-            buffer.clear();
-        }
-    }
-
-    if (!buffer.empty())
-        result.push_back(buffer);
-
-    if (at_most > 0 and at_most < result.size())
-        result.erase(result.begin() + at_most, result.end());
-
-    return result;
-}
-
-///@brief Split a string into a vector of strings, return an element of said vector
-///
-/// @param  input_s string to split
-/// @param  split_on character by which to split the string
-/// @param  at_most number of (sub)strings generated
-/// @param  index of the (sub)string to be returned
-/// @return a substring of @input_s, identified by @index
-std::string splitThenGetAt(const std::string& input_s, char split_on, std::size_t index)
+template <typename UnaryPredicate> constexpr std::string strip(std::string s, UnaryPredicate p)
 {
-    const auto splits { split(input_s, split_on) };
-
-    return splits.at(index);
-}
-
-///@brief Split a string into lines and store them as a vector
-///
-/// @param s string to split
-/// @return a vector of substrings obtained by splitting @s on newline characters
-strings splitLines(const std::string& s)
-{
-    return split(s, '\n');
-}
-
-///@brief Split the contents of a file into lines and store them as a vector
-///
-/// @param from_location file path
-/// @return a vector of strings containing the lines of the file
-/// @note empty lines are discarded
-strings splitFileLines(const std::string& from_location)
-{
-    std::fstream in_f(from_location, std::ios::in);
-    std::string line_read {};
-    strings lines {};
-
-    if (in_f.is_open()) {
-        for (; std::getline(in_f, line_read);)
-            if (!line_read.empty())
-                lines.emplace_back(line_read);
-    } else {
-        std::cerr << "Error: could not open file." << std::endl;
-    }
-
-    if (lines.empty())
-        lines.emplace_back("");
-
-    return lines;
+    stripInPlace(s, p);
+    return s;
 }
 
-} // namespace pypp
-
-namespace collections {
-
-/// @brief A collection of key-value pairs, where:
-///        - elements [Generic] are stored as <Keys>
-///        - element counts [int] are stored as <Values>
-template <class Key, class Hash = std::hash<Key>> class Counter {
+/// @brief A small set of delimiter characters, matched in a single pass over the input
+///        Implicitly constructible from a single character or from a string of characters
+class Delimiters {
 public:
-    using vecKeyIt = typename std::vector<Key>::iterator;
-    using vecValueIt = typename std::vector<int>::iterator;
-    using vecKeyValueIt = typename std::vector<std::pair<Key, int>>::iterator;
+    /// Max number of delimiters compared per vector block, larger sets use the scalar scanner
+    static constexpr std::size_t max_vectorized = 16U;
 
-    Counter() = default;
+    constexpr Delimiters() = default;
 
-    template <class InputIt> Counter(InputIt first, InputIt last)
+    constexpr Delimiters(char c)
     {
-        for (; first != last; ++first) {
-            umap_[*first] += 1;
-        }
-
-        keys_.reserve(umap_.size());
-        counts_.reserve(umap_.size());
-        items_.reserve(umap_.size());
+        insert(c);
     }
 
-    Counter(const Counter& other) = delete;
-
-    Counter& operator=(const Counter& other) = delete;
-
-    Counter(Counter&& other) = delete;
-
-    Counter& operator=(Counter&& other) = delete;
-
-    /// @brief (Psuedo-) copy-constructor
-    ///        Implicit conversion from std::unordered_map<Key, int> -> Counter is allowed
-    template <class T> Counter(const std::unordered_map<T, int>& other_map)
+    constexpr Delimiters(const char* chars)
+        : Delimiters(std::string_view(chars))
     {
-        static_assert(std::is_same_v<Key, T> == true,
-            "Assignment Error: Can not construct Counter from incompatible Key type: {}");
-
-        this->umap_ = other_map;
     }
 
-    /// @brief (Psuedo-) copy-assignment
-    ///        Implicit conversion from std::unordered_map<Key, int> -> Counter is allowed
-    template <class T> Counter& operator=(const std::unordered_map<T, int>& other_map)
+    constexpr Delimiters(std::string_view chars)
     {
-        static_assert(std::is_same_v<Key, T> == true,
-            "Assignment Error: Can not assing to Counter from incompatible Key type: {}");
-        // @note, possible TODO : cannot check for equality to existing map;
-        // would need to overload operator==
-
-        this->umap_ = other_map;
-        return *this;
+        for (const char c : chars)
+            insert(c);
     }
 
-    /// @brief Retrieve underlying map
-    std::unordered_map<Key, int, Hash> getUnderlyingMap() const
+    constexpr bool contains(char c) const
     {
-        return umap_;
+        const auto uc = static_cast<unsigned char>(c);
+        return (bits_[uc >> 6U] >> (uc & 63U)) & 1U;
     }
 
-    /// @brief Wrapper of std::unordered_map<>::size()
-    std::size_t size()
+    constexpr std::size_t size() const
     {
-        return umap_.size();
+        return size_;
     }
 
-    /// @brief Wrapper of std::unordered_map<>::empty()
-    bool empty()
+    constexpr char operator[](std::size_t i) const
     {
-        return umap_.empty();
+        return static_cast<char>(patterns_[i] & 0xffU);
     }
 
-    /// @brief Wrapper of std::unordered_map<>::operator[]
-    ///
-    /// @note Return value is reference to int (int&) to allow to modify it
-    /// @note Complexity:
-    ///       - avg: constant
-    ///       - woc: linear in size
-    ///
-    /// @param key
-    int& operator[](const Key& key)
-    {
-        typename std::vector<Key>::iterator start {};
-        typename std::vector<Key>::iterator end {};
-        std::tie(start, end) = this->keys();
-        std::set<Key> key_set(start, end);
-        if (!key_set.contains(key))
-            umap_[key] = 0;
-        return umap_[key];
-    }
-    int& operator[](Key&& key)
+    /// @return the @i-th delimiter repeated in every byte of a word, i.e. ready to broadcast to a vector
+    ///         register without per-search setup, for i < max_vectorized
+    constexpr std::uint64_t pattern(std::size_t i) const
     {
-        typename std::vector<Key>::iterator start {};
-        typename std::vector<Key>::iterator end {};
-        std::tie(start, end) = this->keys();
-        std::set<Key> key_set(start, end);
-        if (!key_set.contains(key))
-            umap_[key] = 0;
-        return umap_[key];
+        return patterns_[i];
     }
 
-    /// @brief Return a pair of begin and end iterators to the keys
-    ///
-    /// @return A pair of iterators to a std::vector<Key>
-    std::pair<vecKeyIt, vecKeyIt> keys()
+private:
+    constexpr void insert(char c)
     {
-        keys_.clear();
-        for (const auto& pair : umap_)
-            keys_.push_back(pair.first);
+        if (contains(c))
+            return;
 
-        return std::make_pair<vecKeyIt, vecKeyIt>(keys_.begin(), keys_.end());
+        const auto uc = static_cast<unsigned char>(c);
+        bits_[uc >> 6U] |= std::uint64_t { 1 } << (uc & 63U);
+        if (size_ < max_vectorized)
+            patterns_[size_] = std::uint64_t { uc } * 0x0101010101010101U;
+        ++size_;
     }
 
-    /// @brief Return a pair of begin and end iterarors to the counts
-    ///
-    /// @return A pair of iterators to a std::vector<int>
-    std::pair<vecValueIt, vecValueIt> values()
-    {
-        counts_.clear();
-        for (const auto& pair : umap_)
-            counts_.push_back(pair.second);
+    std::array<std::uint64_t, 4U> bits_ {};
+    std::array<std::uint64_t, max_vectorized> patterns_ {};
+    std::size_t size_ { 0U };
+};
 
-        return std::make_pair<vecValueIt, vecValueIt>(counts_.begin(), counts_.end());
-    }
+namespace detail {
 
-    /// @brief Return a pair of begin and end iterators to the keys and counts
+    /// @brief Position of the first character of @s at or after @from which is in @delims
+    ///        Reference implementation, one character at a time
     ///
-    /// @return A pair of iterators to a std::vector<std::pair<Key, int>>
-    std::pair<vecKeyValueIt, vecKeyValueIt> items()
+    /// @return the position found, or std::string_view::npos
+    std::size_t findFirstOfScalar(std::string_view s, std::size_t from, const Delimiters& delims)
     {
-        items_.clear();
-        for (const auto& pair : umap_)
-            items_.push_back(pair);
+        for (; from < s.size(); ++from)
+            if (delims.contains(s[from]))
+                return from;
 
-        return std::make_pair<vecKeyValueIt, vecKeyValueIt>(items_.begin(), items_.end());
+        return std::string_view::npos;
     }
 
-    /// @brief Return an iterator over elements, repeating each as many time as its count.
-    /// @note If an element's count is < 1 it is ignored
+    /// @brief Position of the first character of @s at or after @from which is in @delims
+    ///        Compares 32 (AVX2) or 16 (SSE2) characters at a time against every delimiter,
+    ///        the instruction set is picked at compile time; define PYPP_NO_SIMD to disable it
     ///
-    /// @return A pair of iterators to a std::vector<Key>
-    std::pair<vecKeyIt, vecKeyIt> elements()
+    /// @return the position found, or std::string_view::npos
+    /// @note Returns exactly what findFirstOfScalar() returns
+    std::size_t findFirstOfVector(std::string_view s, std::size_t from, const Delimiters& delims)
     {
-        auto vec_pair_key_int = this->mostCommon();
+#if !defined(PYPP_NO_SIMD) && (defined(__AVX2__) || defined(__SSE2__))
+        if (delims.size() == 0U || delims.size() > Delimiters::max_vectorized)
+            return findFirstOfScalar(s, from, delims);
 
-        elems_.clear();
-        for (const auto& pair : vec_pair_key_int) {
-            int count = pair.second;
-            while (count-- > 0)
-                elems_.push_back(pair.first);
-        }
+        const char* data = s.data();
+#if defined(__AVX2__)
+        using block_t = __m256i;
+        constexpr std::size_t width { 32U };
+        const auto load
+            = [](const char* p) { return _mm256_loadu_si256(reinterpret_cast<const block_t*>(p)); };
+        const auto broadcast
+            = [](std::uint64_t pattern) { return _mm256_set1_epi64x(static_cast<long long>(pattern)); };
+        const auto matches = [](block_t block, block_t delim) { return _mm256_cmpeq_epi8(block, delim); };
+        const auto merge = [](block_t lhs, block_t rhs) { return _mm256_or_si256(lhs, rhs); };
+        const auto toMask
+            = [](block_t block) { return static_cast<std::uint32_t>(_mm256_movemask_epi8(block)); };
+#else
+        using block_t = __m128i;
+        constexpr std::size_t width { 16U };
+        const auto load = [](const char* p) { return _mm_loadu_si128(reinterpret_cast<const block_t*>(p)); };
+        const auto broadcast
+            = [](std::uint64_t pattern) { return _mm_set1_epi64x(static_cast<long long>(pattern)); };
+        const auto matches = [](block_t block, block_t delim) { return _mm_cmpeq_epi8(block, delim); };
+        const auto merge = [](block_t lhs, block_t rhs) { return _mm_or_si128(lhs, rhs); };
+        const auto toMask
+            = [](block_t block) { return static_cast<std::uint32_t>(_mm_movemask_epi8(block)); };
+#endif
+        // the patterns are pre-broadcast to words by Delimiters: widening one to a register is a single load
+        for (; from + width <= s.size(); from += width) {
+            const auto block = load(data + from);
+            auto hits = matches(block, broadcast(delims.pattern(0U)));
+            for (std::size_t k = 1U; k < delims.size(); ++k)
+                hits = merge(hits, matches(block, broadcast(delims.pattern(k))));
 
-        return std::make_pair<vecKeyIt, vecKeyIt>(elems_.begin(), elems_.end());
+            if (const auto mask = toMask(hits); mask != 0U)
+                return from + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+#endif
+        return findFirstOfScalar(s, from, delims);
     }
 
-    /// @brief Return the `n` most common elements and their counts sorted by most to least common.
+    /// @brief Position of the first character of @s at or after @from which is not in @delims
     ///
-    /// @param n Max number of elements returned
-    /// @return A std::vector of std::pair<Key, int> representing the elements and their corresponding counts
-    /// @note By default returns all elements in the Counter
-    std::vector<std::pair<Key, int>> mostCommon(int8_t n = 0) const
+    /// @return the position found, or std::string_view::npos
+    std::size_t findFirstNotOf(std::string_view s, std::size_t from, const Delimiters& delims)
     {
-        std::vector<std::pair<Key, int>> t_v {};
-        t_v.reserve(umap_.size());
+        for (; from < s.size(); ++from)
+            if (!delims.contains(s[from]))
+                return from;
 
-        for (const auto& pair : umap_)
-            t_v.push_back(pair);
+        return std::string_view::npos;
+    }
 
-        std::sort(std::begin(t_v), std::end(t_v),
-            [](const std::pair<Key, int> p1, const std::pair<Key, int> p2) { return p1.second > p2.second; });
+} // namespace detail
 
-        const auto endIt = (n > 0 && n < umap_.size()) ? std::begin(t_v) + n : std::end(t_v);
-        return std::vector<std::pair<Key, int>>(std::begin(t_v), endIt);
-    }
+/// @brief Lazy range over the tokens of a string split on one or more delimiter characters
+///        Tokens are std::string_view pointing into the original input, empty tokens are skipped
+///
+/// @note The range does not own its input: the underlying buffer must outlive it
+class SplitRange : public std::ranges::view_interface<SplitRange> {
+public:
+    class iterator {
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
 
-    /// @brief Return the sum of all counts.
-    ///
-    /// @return The sum of all counts
-    int total() const
-    {
-        if (umap_.empty())
-            return 0;
+        iterator() = default;
 
-        int sum { 0 };
-        for (const auto& pair : umap_)
-            sum += pair.second;
+        iterator(std::string_view rest, const Delimiters& split_on)
+            : rest_ { rest }
+            , split_on_ { split_on }
+        {
+            next();
+        }
 
-        return sum;
+        std::string_view operator*() const
+        {
+            return token_;
+        }
+
+        iterator& operator++()
+        {
+            next();
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            auto tmp = *this;
+            next();
+            return tmp;
+        }
+
+        friend bool operator==(const iterator& lhs, const iterator& rhs)
+        {
+            return lhs.done_ == rhs.done_ && lhs.token_.data() == rhs.token_.data();
+        }
+
+        friend bool operator==(const iterator& it, std::default_sentinel_t)
+        {
+            return it.done_;
+        }
+
+    private:
+        void next()
+        {
+            const auto first = detail::findFirstNotOf(rest_, 0U, split_on_);
+            if (first == std::string_view::npos) {
+                rest_ = {};
+                token_ = {};
+                done_ = true;
+                return;
+            }
+
+            rest_.remove_prefix(first);
+            const auto last = std::min(detail::findFirstOfVector(rest_, 0U, split_on_), rest_.size());
+            token_ = rest_.substr(0, last);
+            rest_.remove_prefix(last);
+            done_ = false;
+        }
+
+        std::string_view rest_ {};
+        std::string_view token_ {};
+        Delimiters split_on_ {};
+        bool done_ { true };
+    };
+
+    SplitRange() = default;
+
+    SplitRange(std::string_view input_s, Delimiters split_on)
+        : input_ { input_s }
+        , split_on_ { split_on }
+    {
     }
 
-    // for debugging purposes
-    void pprint()
+    iterator begin() const
     {
-        std::cout << "-----" << std::endl;
-        for (const auto elem : umap_)
-            std::cout << elem.first << ": " << elem.second << std::endl;
-        std::cout << "-----" << std::endl;
+        return iterator(input_, split_on_);
+    }
+
+    std::default_sentinel_t end() const
+    {
+        return std::default_sentinel;
     }
 
 private:
-    std::unordered_map<Key, int, Hash> umap_ {};
-    std::vector<Key> elems_ {};
-    std::vector<Key> keys_ {};
-    std::vector<int> counts_ {};
-    std::vector<std::pair<Key, int>> items_ {};
+    std::string_view input_ {};
+    Delimiters split_on_ {};
 };
 
-template<typename T>
-concept TupleLike = requires (T t)
-{
-    std::get<0>(t);
-    std::get<1>(t);
-};
+namespace detail {
 
-struct TupleHash {
-    template <TupleLike T>
-    auto operator()(const T& t) const noexcept -> std::size_t
+    /// @brief Append the tokens of @input_s to @result, at most @at_most of them if positive
+    template <class Container>
+    void splitInto(Container& result, std::string_view input_s, Delimiters split_on, int at_most)
     {
-        return std::hash<typename std::tuple_element<0, T>::type>{}(std::get<0>(t)) ^
-               std::hash<typename std::tuple_element<1, T>::type>{}(std::get<1>(t));
+        for (const auto token : SplitRange(input_s, split_on)) {
+            result.emplace_back(token);
+            if (at_most > 0 and result.size() == static_cast<std::size_t>(at_most))
+                break;
+        }
     }
-};
 
-} // namespace collections
+} // namespace detail
 
-namespace pypp {
+///@brief Split a string lazily, producing one token at a time
+///
+/// @param  input_s string to split
+/// @param  split_on character(s) by which to split the string
+/// @return a lazy range of std::string_view tokens obtained by splitting @input_s on any of @split_on
+/// @note Tokens point into @input_s, which must outlive the range
+SplitRange splitRange(std::string_view input_s, Delimiters split_on)
+{
+    return SplitRange(input_s, split_on);
+}
 
-/// @brief Default case, when all other arguments have been dealt with.
-///        Advances the last iterator.
-template <class Iterator> void advanceIterators(Iterator&& iterator)
+///@brief Split a string into a vector of views, without copying any character
+///
+/// @param  input_s string to split
+/// @param  split_on character(s) by which to split the string
+/// @param  at_most number of (sub)strings generated
+/// @return a vector of views obtained by splitting @input_s on any of @split_on
+/// @note Views point into @input_s, which must outlive them
+std::vector<std::string_view> splitView(std::string_view input_s, Delimiters split_on, int at_most = -1)
 {
-    std::advance(iterator, 1);
+    std::vector<std::string_view> result {};
+    detail::splitInto(result, input_s, split_on, at_most);
+
+    return result;
 }
 
-/// @brief Advances the first iterator and forwards the rest of the variadic arguments
-template <class Iterator, class... Iterators>
-void advanceIterators(Iterator&& iterator, Iterators&&... iterators)
+///@brief Split a string into a vector of views allocated from @resource, see splitView()
+pmr::string_views splitView(
+    std::string_view input_s, Delimiters split_on, std::pmr::memory_resource& resource, int at_most = -1)
 {
-    std::advance(iterator, 1);
-    advanceIterators(std::forward<Iterators>(iterators)...);
+    pmr::string_views result { &resource };
+    detail::splitInto(result, input_s, split_on, at_most);
+
+    return result;
 }
 
-/// @brief Return an iterable of tuples, where the i-th tuple contains the i-th element
-///        from each of the argument iterables.
-///        It turns rows into columns, and colums into rows (similar to transposing a matrix)
-template <class Iterator, class... Iterators> auto zip(Iterator begin, Iterator end, Iterators... iterators)
+///@brief Split a string into a vector of strings
+///
+/// @param  input_s string to split
+/// @param  split_on character(s) by which to split the string
+/// @param  at_most number of (sub)strings generated
+/// @return a vector of substrings obtained by splitting @input_s on any of @split_on
+strings split(const std::string& input_s, Delimiters split_on, int at_most = -1)
 {
-    std::vector<std::tuple<typename Iterator::value_type, typename Iterators::value_type...>> result {};
-    for (; begin != end; ++begin, advanceIterators(iterators...))
-        result.push_back(std::make_tuple(*begin, *iterators...));
+    strings result {};
+    detail::splitInto(result, input_s, split_on, at_most);
 
     return result;
 }
 
-} // namespace pypp
+///@brief Split a string into a vector of strings whose memory comes from @resource, see split()
+///
+/// @param resource e.g. an Arena, used for the vector and for every substring
+pmr::strings split(
+    std::string_view input_s, Delimiters split_on, std::pmr::memory_resource& resource, int at_most = -1)
+{
+    pmr::strings result { &resource };
+    detail::splitInto(result, input_s, split_on, at_most);
 
-namespace grid {
+    return result;
+}
 
-using Location = std::pair<int, int>;
+///@brief Split a string, return one of the resulting substrings
+///
+/// @param  input_s string to split
+/// @param  split_on character(s) by which to split the string
+/// @param  index of the (sub)string to be returned
+/// @return a substring of @input_s, identified by @index
+/// @throw std::out_of_range if @input_s has fewer than @index + 1 substrings
+/// @note The input is only scanned up to the requested substring
+std::string splitThenGetAt(const std::string& input_s, Delimiters split_on, std::size_t index)
+{
+    for (const auto token : splitRange(input_s, split_on))
+        if (index-- == 0)
+            return std::string(token);
 
-enum class Direction {
-    UP = 0,
-    DOWN,
-    LEFT,
-    RIGHT,
-};
+    throw std::out_of_range("splitThenGetAt: index out of range");
+}
 
-/// @return an iterable of possible {dx, dy} when moving within a 2d grid
-std::array<Location, 4U> move()
+///@brief Split a string into lines and store them as a vector
+///
+/// @param s string to split
+/// @return a vector of substrings obtained by splitting @s on newline characters
+strings splitLines(const std::string& s)
 {
-    return { std::make_pair(-1, 0), std::make_pair(1, 0), std::make_pair(0, 1), std::make_pair(0, -1) };
+    return split(s, '\n');
 }
 
-/// @return an iterable of possible {{dx, dy}, DIR} when moving within a 2d grid
-std::array<std::pair<Location, Direction>, 4U> moveWithDIR()
+///@brief Split a string into lines whose memory comes from @resource, see splitLines()
+pmr::strings splitLines(std::string_view s, std::pmr::memory_resource& resource)
 {
-    return { std::make_pair(std::make_pair(-1, 0), Direction::UP),
-        std::make_pair(std::make_pair(1, 0), Direction::DOWN),
-        std::make_pair(std::make_pair(0, 1), Direction::LEFT),
-        std::make_pair(std::make_pair(0, -1), Direction::RIGHT) };
+    return split(s, '\n', resource);
 }
 
-bool inBounds(const strings& grid, int x, int y)
+///@brief Split a string into lines, without copying any character
+///
+/// @param s string to split
+/// @return a vector of views obtained by splitting @s on newline characters
+/// @note Views point into @s, which must outlive them
+std::vector<std::string_view> splitLinesView(std::string_view s)
 {
-    const auto n = grid.size();
-    const auto m = grid[0].length();
+    return splitView(s, '\n');
+}
 
-    return 0 <= x && x < n && 0 <= y && y < m;
+///@brief Split a string into a vector of line views allocated from @resource, see splitLinesView()
+pmr::string_views splitLinesView(std::string_view s, std::pmr::memory_resource& resource)
+{
+    return splitView(s, '\n', resource);
 }
 
-} // namespace grid
+/// @brief Options controlling which lines of a buffer are produced
+struct LinesOptions {
+    /// Discard empty lines
+    bool skip_blank { true };
+    /// Produce a single empty line if the buffer would otherwise produce none
+    bool empty_as_blank_line { true };
+};
 
-namespace algorithms {
+/// @brief Lazy range over the lines of a buffer, with std::getline semantics:
+///        lines end on newline characters, which are not part of the line,
+///        and a trailing newline does not start an additional line
+///
+/// @note The range does not own its input: the underlying buffer must outlive it
+class LineRange : public std::ranges::view_interface<LineRange> {
+public:
+    class iterator {
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        iterator(std::string_view rest, LinesOptions options)
+            : rest_ { rest }
+            , options_ { options }
+        {
+            next();
+        }
+
+        std::string_view operator*() const
+        {
+            return line_;
+        }
+
+        iterator& operator++()
+        {
+            next();
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            auto tmp = *this;
+            next();
+            return tmp;
+        }
+
+        friend bool operator==(const iterator& lhs, const iterator& rhs)
+        {
+            return lhs.done_ == rhs.done_ && lhs.line_.data() == rhs.line_.data() && lhs.count_ == rhs.count_;
+        }
+
+        friend bool operator==(const iterator& it, std::default_sentinel_t)
+        {
+            return it.done_;
+        }
+
+    private:
+        void next()
+        {
+            while (!rest_.empty()) {
+                const auto eol = detail::findFirstOfVector(rest_, 0U, '\n');
+                line_ = rest_.substr(0, eol);
+                rest_.remove_prefix(eol == std::string_view::npos ? rest_.size() : eol + 1U);
 
-/// @brief Dept-First-Search iterative implementation using std::stack
+                if (!options_.skip_blank || !line_.empty()) {
+                    ++count_;
+                    done_ = false;
+                    return;
+                }
+            }
+
+            line_ = {};
+            done_ = count_ > 0U || !options_.empty_as_blank_line;
+            ++count_;
+        }
+
+        std::string_view rest_ {};
+        std::string_view line_ {};
+        LinesOptions options_ {};
+        std::size_t count_ { 0U };
+        bool done_ { true };
+    };
+
+    LineRange() = default;
+
+    LineRange(std::string_view buffer, LinesOptions options = {})
+        : buffer_ { buffer }
+        , options_ { options }
+    {
+    }
+
+    iterator begin() const
+    {
+        return iterator(buffer_, options_);
+    }
+
+    std::default_sentinel_t end() const
+    {
+        return std::default_sentinel;
+    }
+
+private:
+    std::string_view buffer_ {};
+    LinesOptions options_ {};
+};
+
+/// @brief Read-only view of the whole contents of a file.
+///        Regular files are memory-mapped, anything else (pipes, character devices, stdin as "-")
+///        is read into an internal buffer
 ///
-/// @tparam condition predicate to satisfy when exploring locations
-/// @param grid a 2d grid
-/// @param start start grid location
-/// @param visited a set of already visited locations on the grid
-/// @return a vector of reached locations which satisfy @condition
-template <typename Predicate>
-std::vector<grid::Location> dfs(const strings& grid, const grid::Location& start, Predicate condition,
-    std::unordered_set<grid::Location, collections::TupleHash>& visited)
+/// @note The contents do not move with the object: views into them survive moves of the MappedFile
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    /// @param path file path, or "-" for the standard input
+    explicit MappedFile(const std::string& path)
+    {
+        open(path);
+    }
+
+    MappedFile(const MappedFile& other) = delete;
+
+    MappedFile& operator=(const MappedFile& other) = delete;
+
+    MappedFile(MappedFile&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    MappedFile& operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other) {
+            unmap();
+            buffer_ = std::move(other.buffer_);
+            data_ = other.data_;
+            size_ = other.size_;
+            mapped_ = other.mapped_;
+            error_ = other.error_;
+            other.data_ = nullptr;
+            other.size_ = 0U;
+            other.mapped_ = false;
+            other.error_ = {};
+        }
+        return *this;
+    }
+
+    ~MappedFile()
+    {
+        unmap();
+    }
+
+    /// @brief Reason why the file could not be read, if any
+    const std::error_code& error() const
+    {
+        return error_;
+    }
+
+    bool isOpen() const
+    {
+        return !error_;
+    }
+
+    /// @brief Whether the contents are memory-mapped rather than buffered
+    bool isMapped() const
+    {
+        return mapped_;
+    }
+
+    /// @brief Contents of the file
+    std::string_view view() const
+    {
+        return { data_, size_ };
+    }
+
+    /// @brief Lazy range over the lines of the file
+    LineRange lines(LinesOptions options = {}) const
+    {
+        return LineRange(view(), options);
+    }
+
+private:
+    void open(const std::string& path)
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        const bool is_stdin = path == "-";
+        const int fd = is_stdin ? STDIN_FILENO : ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            error_ = std::error_code(errno, std::generic_category());
+            return;
+        }
+
+        // the standard input is always read, even when redirected from a regular file: mapping it would
+        // repeat what was already consumed from it, and it must not be closed
+        struct stat info { };
+        if (!is_stdin && ::fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+            const auto size = static_cast<std::size_t>(info.st_size);
+            void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED) {
+                ::madvise(addr, size, MADV_SEQUENTIAL);
+                data_ = static_cast<const char*>(addr);
+                size_ = size;
+                mapped_ = true;
+                ::close(fd);
+                return;
+            }
+        }
+
+        buffer_ = std::make_unique<std::string>();
+        std::array<char, 1U << 16U> chunk {};
+        for (;;) {
+            const auto n = ::read(fd, chunk.data(), chunk.size());
+            if (n > 0)
+                buffer_->append(chunk.data(), static_cast<std::size_t>(n));
+            else if (n == 0)
+                break;
+            else if (errno != EINTR) {
+                error_ = std::error_code(errno, std::generic_category());
+                break;
+            }
+        }
+
+        if (!is_stdin)
+            ::close(fd);
+#else
+        std::ifstream in_f(path, std::ios::in | std::ios::binary);
+        if (!in_f.is_open()) {
+            error_ = std::make_error_code(std::errc::no_such_file_or_directory);
+            return;
+        }
+        buffer_ = std::make_unique<std::string>(
+            std::istreambuf_iterator<char>(in_f), std::istreambuf_iterator<char>());
+#endif
+        data_ = buffer_->data();
+        size_ = buffer_->size();
+    }
+
+    void unmap()
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        if (mapped_)
+            ::munmap(const_cast<char*>(data_), size_);
+#endif
+        mapped_ = false;
+    }
+
+    const char* data_ { nullptr };
+    std::size_t size_ { 0U };
+    bool mapped_ { false };
+    /// contents read without mapping, behind a pointer so that short (in-place) strings do not move
+    std::unique_ptr<std::string> buffer_ {};
+    std::error_code error_ {};
+};
+
+///@brief Split the contents of a file into lines and store them as a vector
+///
+/// @param from_location file path
+/// @param ec set to the reason why the file could not be read, cleared otherwise
+/// @return a vector of strings containing the lines of the file
+/// @note empty lines are discarded
+strings splitFileLines(const std::string& from_location, std::error_code& ec)
 {
-    auto x = start.first;
-    auto y = start.second;
-    std::stack<grid::Location> stack {};
-    stack.push({ x, y });
-    std::vector<grid::Location> locations {};
+    const MappedFile file(from_location);
+    ec = file.error();
 
-    while (!stack.empty()) {
-        auto [cx, cy] = stack.top();
-        stack.pop();
+    strings lines {};
+    for (const auto line : file.lines())
+        lines.emplace_back(line);
+
+    return lines;
+}
+
+///@brief Split the contents of a file into lines whose memory comes from @resource, see splitFileLines()
+pmr::strings splitFileLines(
+    const std::string& from_location, std::error_code& ec, std::pmr::memory_resource& resource)
+{
+    const MappedFile file(from_location);
+    ec = file.error();
+
+    pmr::strings lines { &resource };
+    for (const auto line : file.lines())
+        lines.emplace_back(line);
+
+    return lines;
+}
 
-        if (visited.find({ cx, cy }) == visited.end() && condition(grid[cx][cy])) {
-            visited.insert({ cx, cy });
-            locations.push_back({ cx, cy });
+///@brief Split the contents of a file into lines and store them as a vector
+///
+/// @param from_location file path
+/// @return a vector of strings containing the lines of the file
+/// @note empty lines are discarded
+strings splitFileLines(const std::string& from_location)
+{
+    std::error_code ec {};
+    auto lines = splitFileLines(from_location, ec);
+
+    if (ec)
+        std::cerr << "Error: could not open file." << std::endl;
+
+    return lines;
+}
+
+///@brief Split the contents of a file into lines whose memory comes from @resource, see splitFileLines()
+pmr::strings splitFileLines(const std::string& from_location, std::pmr::memory_resource& resource)
+{
+    std::error_code ec {};
+    auto lines = splitFileLines(from_location, ec, resource);
+
+    if (ec)
+        std::cerr << "Error: could not open file." << std::endl;
 
-            for (auto [dx, dy] : grid::move()) {
-                auto nx = cx + dx;
-                auto ny = cy + dy;
-                if (grid::inBounds(grid, nx, ny) && visited.find({ nx, ny }) == visited.end())
-                    stack.push({ nx, ny });
+    return lines;
+}
+
+/// @brief Options controlling how a buffer is cut and processed in parallel
+struct ChunkOptions {
+    /// Approximate number of bytes per chunk, chunks are extended up to the next newline
+    std::size_t chunk_size { 1U << 22U };
+    /// Number of worker threads, 0 means std::thread::hardware_concurrency()
+    unsigned threads { 0U };
+};
+
+namespace detail {
+
+    /// @brief Cut a buffer into consecutive chunks of at least @chunk_size bytes,
+    ///        each of them ending right after a newline character (but the last one)
+    std::vector<std::string_view> newlineAlignedChunks(std::string_view buffer, std::size_t chunk_size)
+    {
+        std::vector<std::string_view> chunks {};
+        chunk_size = std::max<std::size_t>(chunk_size, 1U);
+
+        for (std::size_t start = 0U; start < buffer.size();) {
+            std::size_t end { buffer.size() };
+            if (chunk_size < buffer.size() - start) {
+                const auto eol = findFirstOfVector(buffer, start + chunk_size - 1U, '\n');
+                end = eol == std::string_view::npos ? buffer.size() : eol + 1U;
             }
+            chunks.push_back(buffer.substr(start, end - start));
+            start = end;
         }
+
+        return chunks;
     }
 
-    return locations;
+    /// @brief Call @task(i) for every i in [0, @count) from a pool of worker threads
+    /// @note The first exception thrown by a task is rethrown once every worker has joined
+    template <class Task> void parallelFor(std::size_t count, unsigned threads, Task&& task)
+    {
+        if (threads == 0U)
+            threads = std::max(1U, std::thread::hardware_concurrency());
+        threads = static_cast<unsigned>(std::min<std::size_t>(threads, count));
+
+        std::atomic<std::size_t> next { 0U };
+        std::exception_ptr failure {};
+        std::mutex failure_mutex {};
+
+        const auto work = [&]() {
+            try {
+                for (auto i = next.fetch_add(1U); i < count; i = next.fetch_add(1U))
+                    task(i);
+            } catch (...) {
+                const std::lock_guard<std::mutex> lock(failure_mutex);
+                if (!failure)
+                    failure = std::current_exception();
+                next = count;
+            }
+        };
+
+        if (threads <= 1U) {
+            work();
+        } else {
+            std::vector<std::thread> workers {};
+            workers.reserve(threads - 1U);
+            for (unsigned t = 1U; t < threads; ++t)
+                workers.emplace_back(work);
+            work();
+            for (auto& worker : workers)
+                worker.join();
+        }
+
+        if (failure)
+            std::rethrow_exception(failure);
+    }
+
+} // namespace detail
+
+/// @brief Cut a buffer into newline-aligned chunks and hand each of them to @process
+///        on a worker thread
+///
+/// @tparam process callable as process(chunk_index, chunk)
+/// @param buffer contents to process, e.g. MappedFile::view()
+/// @param options chunk size and number of threads
+template <class ChunkFn>
+void forEachChunk(std::string_view buffer, ChunkFn process, ChunkOptions options = {})
+{
+    const auto chunks = detail::newlineAlignedChunks(buffer, options.chunk_size);
+    detail::parallelFor(
+        chunks.size(), options.threads, [&](std::size_t i) { std::invoke(process, i, chunks[i]); });
+}
+
+/// @brief Cut a buffer into newline-aligned chunks, parse each of them on a worker thread
+///        and collect the results
+///
+/// @tparam parse callable as parse(chunk), returning the parsed representation of a chunk
+/// @param buffer contents to parse, e.g. MappedFile::view()
+/// @param options chunk size and number of threads
+/// @return the results of @parse, in chunk order
+template <class ChunkFn>
+auto mapChunks(std::string_view buffer, ChunkFn parse, ChunkOptions options = {})
+    -> std::vector<std::invoke_result_t<ChunkFn&, std::string_view>>
+{
+    const auto chunks = detail::newlineAlignedChunks(buffer, options.chunk_size);
+    std::vector<std::invoke_result_t<ChunkFn&, std::string_view>> results(chunks.size());
+    detail::parallelFor(
+        chunks.size(), options.threads, [&](std::size_t i) { results[i] = parse(chunks[i]); });
+
+    return results;
+}
+
+namespace detail {
+
+    /// @brief Fill the empty vector @lines with the lines of @buffer, see parallelSplitLines()
+    template <class Lines>
+    Lines parallelSplitLinesInto(
+        Lines lines, std::string_view buffer, LinesOptions lines_options, ChunkOptions options)
+    {
+        const LinesOptions chunk_lines_options { lines_options.skip_blank, false };
+        const auto per_chunk = mapChunks(
+            buffer,
+            [&](std::string_view chunk) {
+                std::vector<std::string_view> chunk_lines {};
+                for (const auto line : LineRange(chunk, chunk_lines_options))
+                    chunk_lines.push_back(line);
+                return chunk_lines;
+            },
+            options);
+
+        std::vector<std::size_t> offsets(per_chunk.size() + 1U, 0U);
+        for (std::size_t i = 0U; i < per_chunk.size(); ++i)
+            offsets[i + 1U] = offsets[i] + per_chunk[i].size();
+
+        lines.resize(offsets.back());
+        parallelFor(per_chunk.size(), options.threads, [&](std::size_t i) {
+            std::copy(per_chunk[i].begin(), per_chunk[i].end(), lines.begin() + offsets[i]);
+        });
+
+        if (lines.empty() && lines_options.empty_as_blank_line)
+            lines.emplace_back(buffer.substr(0, 0));
+
+        return lines;
+    }
+
+} // namespace detail
+
+/// @brief Split a buffer into lines on worker threads
+///
+/// @param buffer contents to split, e.g. MappedFile::view()
+/// @param lines_options which lines to produce, see LinesOptions
+/// @param options chunk size and number of threads
+/// @return a contiguous index of views, in the same order as LineRange(@buffer, @lines_options)
+std::vector<std::string_view> parallelSplitLines(
+    std::string_view buffer, LinesOptions lines_options = {}, ChunkOptions options = {})
+{
+    return detail::parallelSplitLinesInto(std::vector<std::string_view> {}, buffer, lines_options, options);
+}
+
+/// @brief Split a buffer into lines on worker threads, into an index allocated from @resource,
+///        see parallelSplitLines()
+/// @note The per-chunk scratch vectors, filled concurrently, still use the default allocator
+pmr::string_views parallelSplitLines(std::string_view buffer, std::pmr::memory_resource& resource,
+    LinesOptions lines_options = {}, ChunkOptions options = {})
+{
+    return detail::parallelSplitLinesInto(pmr::string_views { &resource }, buffer, lines_options, options);
+}
+
+/// @brief The lines of a file, indexed as views into its mapped contents; they remain valid if moved
+struct LineIndex {
+    MappedFile file {};
+    std::vector<std::string_view> lines {};
+};
+
+///@brief Split the contents of a file into lines on worker threads
+///
+/// @param from_location file path
+/// @param lines_options which lines to produce, see LinesOptions
+/// @param options chunk size and number of threads
+/// @return the file and an index of its lines; check file.error() for failures
+/// @note with default options, the lines are the same as the ones of splitFileLines()
+LineIndex parallelSplitFileLines(
+    const std::string& from_location, LinesOptions lines_options = {}, ChunkOptions options = {})
+{
+    LineIndex index { MappedFile(from_location), {} };
+    index.lines = parallelSplitLines(index.file.view(), lines_options, options);
+
+    return index;
+}
+
+/// @brief Table of distinct strings, each identified by a dense id: 0, 1, 2... in order of first interning.
+///        Characters live back to back in a single contiguous pool, and lookups go through an open-addressing
+///        index of ids, so that repeated tokens can be counted, compared and hashed as integers.
+///
+/// @note Views returned by operator[] are invalidated by interning new strings; ids never are
+class Interner {
+public:
+    using id_type = std::uint32_t;
+
+    Interner() = default;
+
+    /// @return the id of @s, interning it first if it is new
+    id_type intern(std::string_view s)
+    {
+        if ((size() + 1U) * 2U > index_.size())
+            rehash(std::max<std::size_t>(index_.size() * 2U, 16U));
+
+        const auto h = hashOf(s);
+        const auto slot = findSlot(s, h);
+        if (index_[slot] != empty_slot)
+            return index_[slot];
+
+        const auto id = static_cast<id_type>(size());
+        pool_.append(s);
+        offsets_.push_back(pool_.size());
+        hashes_.push_back(h);
+        index_[slot] = id;
+        return id;
+    }
+
+    /// @return the id of @s, or std::nullopt if it was never interned
+    std::optional<id_type> find(std::string_view s) const
+    {
+        if (index_.empty())
+            return std::nullopt;
+
+        const auto id = index_[findSlot(s, hashOf(s))];
+        return id == empty_slot ? std::nullopt : std::optional<id_type> { id };
+    }
+
+    bool contains(std::string_view s) const
+    {
+        return find(s).has_value();
+    }
+
+    /// @return the string of @id, pointing into the pool
+    std::string_view operator[](id_type id) const
+    {
+        return std::string_view(pool_).substr(offsets_[id], offsets_[id + 1U] - offsets_[id]);
+    }
+
+    /// @return number of distinct strings
+    std::size_t size() const
+    {
+        return offsets_.size() - 1U;
+    }
+
+    bool empty() const
+    {
+        return size() == 0U;
+    }
+
+    /// @return the pool of characters, the strings back to back in order of their ids
+    std::string_view pool() const
+    {
+        return pool_;
+    }
+
+    /// @brief Make room for @strings strings of @bytes characters in total
+    void reserve(std::size_t strings, std::size_t bytes)
+    {
+        pool_.reserve(bytes);
+        offsets_.reserve(strings + 1U);
+        hashes_.reserve(strings);
+        if (strings * 2U > index_.size())
+            rehash(std::bit_ceil(std::max<std::size_t>(strings * 2U, 16U)));
+    }
+
+    void clear()
+    {
+        pool_.clear();
+        offsets_.assign(1U, 0U);
+        hashes_.clear();
+        index_.clear();
+    }
+
+private:
+    static constexpr id_type empty_slot { std::numeric_limits<id_type>::max() };
+
+    static std::uint64_t hashOf(std::string_view s)
+    {
+        return std::hash<std::string_view> {}(s);
+    }
+
+    /// @brief Slot of @s in the index if interned, otherwise the empty slot where it belongs
+    std::size_t findSlot(std::string_view s, std::uint64_t h) const
+    {
+        const auto mask = index_.size() - 1U;
+        auto slot = static_cast<std::size_t>(h) & mask;
+        for (; index_[slot] != empty_slot; slot = (slot + 1U) & mask) {
+            const auto id = index_[slot];
+            if (hashes_[id] == h && (*this)[id] == s)
+                break;
+        }
+        return slot;
+    }
+
+    void rehash(std::size_t slots)
+    {
+        index_.assign(slots, empty_slot);
+        const auto mask = slots - 1U;
+        for (std::size_t id = 0U; id < hashes_.size(); ++id) {
+            auto slot = static_cast<std::size_t>(hashes_[id]) & mask;
+            while (index_[slot] != empty_slot)
+                slot = (slot + 1U) & mask;
+            index_[slot] = static_cast<id_type>(id);
+        }
+    }
+
+    std::string pool_ {};
+    /// string i is pool_[offsets_[i], offsets_[i + 1])
+    std::vector<std::size_t> offsets_ { 0U };
+    std::vector<std::uint64_t> hashes_ {};
+    /// power-of-two open-addressing table of ids, at most half full
+    std::vector<id_type> index_ {};
+};
+
+/// @brief Interner shared by several threads: lookups of known strings take a shared lock,
+///        only new strings take the exclusive one
+class ConcurrentInterner {
+public:
+    using id_type = Interner::id_type;
+
+    ConcurrentInterner() = default;
+
+    ConcurrentInterner(const ConcurrentInterner& other) = delete;
+
+    ConcurrentInterner& operator=(const ConcurrentInterner& other) = delete;
+
+    /// @return the id of @s, interning it first if it is new
+    id_type intern(std::string_view s)
+    {
+        {
+            const std::shared_lock<std::shared_mutex> lock(mutex_);
+            if (const auto id = interner_.find(s))
+                return *id;
+        }
+
+        const std::unique_lock<std::shared_mutex> lock(mutex_);
+        return interner_.intern(s);
+    }
+
+    /// @return the id of @s, or std::nullopt if it was never interned
+    std::optional<id_type> find(std::string_view s) const
+    {
+        const std::shared_lock<std::shared_mutex> lock(mutex_);
+        return interner_.find(s);
+    }
+
+    /// @return a copy of the string of @id
+    std::string str(id_type id) const
+    {
+        const std::shared_lock<std::shared_mutex> lock(mutex_);
+        return std::string(interner_[id]);
+    }
+
+    std::size_t size() const
+    {
+        const std::shared_lock<std::shared_mutex> lock(mutex_);
+        return interner_.size();
+    }
+
+    /// @brief Retrieve a copy of the table, e.g. for lock-free reverse lookups once interning is done
+    Interner snapshot() const
+    {
+        const std::shared_lock<std::shared_mutex> lock(mutex_);
+        return interner_;
+    }
+
+private:
+    mutable std::shared_mutex mutex_ {};
+    Interner interner_ {};
+};
+
+///@brief Split a string and intern its tokens, producing their ids instead of substrings
+///
+/// @param  input_s string to split
+/// @param  split_on character(s) by which to split the string
+/// @param  interner Interner or ConcurrentInterner receiving the tokens
+/// @param  at_most number of ids generated
+/// @return the ids of the tokens of @input_s, in order, e.g. to feed a Counter or a TupleHash-ed state
+template <class Table>
+std::vector<typename Table::id_type> splitIds(
+    std::string_view input_s, Delimiters split_on, Table& interner, int at_most = -1)
+{
+    std::vector<typename Table::id_type> ids {};
+    for (const auto token : splitRange(input_s, split_on)) {
+        ids.push_back(interner.intern(token));
+        if (at_most > 0 and ids.size() == static_cast<std::size_t>(at_most))
+            break;
+    }
+
+    return ids;
+}
+
+namespace detail {
+
+    bool isDigit(char c)
+    {
+        return static_cast<unsigned char>(c - '0') <= 9U;
+    }
+
+    /// @brief Position of the first decimal digit of @s at or after @from, or std::string_view::npos.
+    ///        Checks 32 (AVX2) or 16 (SSE2) characters at a time, as findFirstOfVector()
+    std::size_t findDigit(std::string_view s, std::size_t from)
+    {
+#if !defined(PYPP_NO_SIMD) && (defined(__AVX2__) || defined(__SSE2__))
+        const char* data = s.data();
+#if defined(__AVX2__)
+        constexpr std::size_t width { 32U };
+        const auto zero = _mm256_set1_epi8('0');
+        const auto nine = _mm256_set1_epi8(9);
+        for (; from + width <= s.size(); from += width) {
+            // c - '0' <= 9 as unsigned bytes, i.e. min(c - '0', 9) == c - '0'
+            const auto offset = _mm256_sub_epi8(
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + from)), zero);
+            const auto digits = _mm256_cmpeq_epi8(_mm256_min_epu8(offset, nine), offset);
+            if (const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(digits)); mask != 0U)
+                return from + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+#else
+        constexpr std::size_t width { 16U };
+        const auto zero = _mm_set1_epi8('0');
+        const auto nine = _mm_set1_epi8(9);
+        for (; from + width <= s.size(); from += width) {
+            // c - '0' <= 9 as unsigned bytes, i.e. min(c - '0', 9) == c - '0'
+            const auto offset
+                = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + from)), zero);
+            const auto digits = _mm_cmpeq_epi8(_mm_min_epu8(offset, nine), offset);
+            if (const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(digits)); mask != 0U)
+                return from + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+#endif
+#endif
+        for (; from < s.size(); ++from)
+            if (isDigit(s[from]))
+                return from;
+
+        return std::string_view::npos;
+    }
+
+} // namespace detail
+
+/// @brief Call @consume(value) for every integer of @text, in order, skipping any other character;
+///        if @consume returns a bool, false stops the scan.
+///        Integers are runs of decimal digits; for signed types, a '-' right before the digits makes
+///        them negative (as the regex -?[0-9]+, so "1-3" gives 1 and -3: use an unsigned type for ranges).
+///
+/// @throw std::out_of_range if an integer does not fit in T
+template <std::integral T, class Consumer> void forEachInt(std::string_view text, Consumer&& consume)
+{
+    const char* const data = text.data();
+    const char* const last = data + text.size();
+    for (auto digit = detail::findDigit(text, 0U); digit != std::string_view::npos;) {
+        auto first = data + digit;
+        if constexpr (std::is_signed_v<T>)
+            if (digit > 0U && first[-1] == '-')
+                --first;
+
+        T value {};
+        const auto [end, error] = std::from_chars(first, last, value);
+        if (error == std::errc::result_out_of_range)
+            throw std::out_of_range("forEachInt: integer out of range: " + std::string(first, end));
+        if constexpr (std::is_same_v<std::invoke_result_t<Consumer&, T>, bool>) {
+            if (!consume(value))
+                return;
+        } else {
+            consume(value);
+        }
+
+        const auto next = static_cast<std::size_t>(end - data);
+        digit = next < text.size() && detail::isDigit(data[next]) ? next : detail::findDigit(text, next);
+    }
+}
+
+/// @brief Parse the integers of @text into @out, see forEachInt()
+///
+/// @return number of integers written, at most @out.size(): parsing stops once @out is full
+template <std::integral T> std::size_t extractInts(std::string_view text, std::span<T> out)
+{
+    std::size_t count { 0U };
+    if (out.empty())
+        return count;
+
+    forEachInt<T>(text, [&](T value) {
+        out[count++] = value;
+        return count < out.size();
+    });
+    return count;
+}
+
+/// @brief Parse the integers of @text, e.g. "x=12, y=-4" gives { 12, -4 }, see forEachInt()
+template <std::integral T = int> std::vector<T> extractInts(std::string_view text)
+{
+    std::vector<T> values {};
+    forEachInt<T>(text, [&](T value) { values.push_back(value); });
+    return values;
+}
+
+/// @brief Parse the integers of @text into a vector allocated from @resource, see extractInts()
+template <std::integral T = int>
+std::pmr::vector<T> extractInts(std::string_view text, std::pmr::memory_resource& resource)
+{
+    std::pmr::vector<T> values { &resource };
+    forEachInt<T>(text, [&](T value) { values.push_back(value); });
+    return values;
+}
+
+/// @brief Integers of the lines of a buffer, stored flat: row i is values[offsets[i], offsets[i + 1])
+template <std::integral T, template <class> class Allocator = std::allocator> struct IntRows {
+    std::vector<T, Allocator<T>> values {};
+    std::vector<std::size_t, Allocator<std::size_t>> offsets { 0U };
+
+    /// @return number of rows
+    std::size_t size() const
+    {
+        return offsets.size() - 1U;
+    }
+
+    std::span<const T> operator[](std::size_t row) const
+    {
+        return { values.data() + offsets[row], offsets[row + 1U] - offsets[row] };
+    }
+};
+
+namespace detail {
+
+    /// @brief Append the integers of every line of @buffer to the empty @rows, see parseInts()
+    template <std::integral T, class Rows>
+    Rows parseIntsInto(Rows rows, std::string_view buffer, LinesOptions options)
+    {
+        for (const auto line : LineRange(buffer, options)) {
+            forEachInt<T>(line, [&](T value) { rows.values.push_back(value); });
+            rows.offsets.push_back(rows.values.size());
+        }
+        return rows;
+    }
+
+} // namespace detail
+
+/// @brief Parse the integers of every line of @buffer in a single allocation-light pass, see forEachInt()
+///
+/// @param buffer contents to parse, e.g. MappedFile::view()
+/// @param options which lines produce a row, see LinesOptions
+template <std::integral T = int> IntRows<T> parseInts(std::string_view buffer, LinesOptions options = {})
+{
+    return detail::parseIntsInto<T>(IntRows<T> {}, buffer, options);
+}
+
+namespace pmr {
+
+    template <std::integral T> using IntRows = pypp::IntRows<T, std::pmr::polymorphic_allocator>;
+
+} // namespace pmr
+
+/// @brief Parse the integers of every line of @buffer into rows allocated from @resource, see parseInts()
+template <std::integral T = int>
+pmr::IntRows<T> parseInts(
+    std::string_view buffer, std::pmr::memory_resource& resource, LinesOptions options = {})
+{
+    pmr::IntRows<T> rows { std::pmr::vector<T>(&resource), std::pmr::vector<std::size_t>(1U, 0U, &resource) };
+    return detail::parseIntsInto<T>(std::move(rows), buffer, options);
+}
+
+/// @brief String literal usable as a template argument, e.g. scan<"x={}", int>()
+template <std::size_t N> struct FixedString {
+    char chars[N] {};
+
+    constexpr FixedString(const char (&s)[N])
+    {
+        std::copy_n(s, N, chars);
+    }
+
+    constexpr std::string_view view() const
+    {
+        return { chars, N - 1U };
+    }
+};
+
+namespace detail {
+
+    /// @brief Pattern of scan(), split at compile time: segments[i] is the literal text before field i,
+    ///        segments.back() the literal text ending the line
+    template <FixedString Pattern> struct ScanPattern {
+        static constexpr std::size_t fields = []() {
+            const auto pattern = Pattern.view();
+            std::size_t count { 0U };
+            for (auto at = pattern.find("{}"); at != std::string_view::npos; at = pattern.find("{}", at + 2U))
+                ++count;
+            return count;
+        }();
+
+        static constexpr std::array<std::string_view, fields + 1U> segments = []() {
+            std::array<std::string_view, fields + 1U> parts {};
+            auto pattern = Pattern.view();
+            for (auto& part : parts) {
+                const auto at = pattern.find("{}");
+                part = pattern.substr(0U, at);
+                pattern = at == std::string_view::npos ? std::string_view {} : pattern.substr(at + 2U);
+            }
+            return parts;
+        }();
+
+        /// @return whether the end of @field is known without parsing it, as needed by text fields
+        static constexpr bool delimited(std::size_t field)
+        {
+            return field + 1U == fields || !segments[field + 1U].empty();
+        }
+    };
+
+    template <class T>
+    constexpr bool is_scan_text = std::same_as<T, std::string_view> || std::same_as<T, std::string>;
+
+    template <class T>
+    concept Scannable
+        = (std::integral<T> && !std::same_as<T, bool>) || std::floating_point<T> || is_scan_text<T>;
+
+    bool scanLiteral(std::string_view& rest, std::string_view literal)
+    {
+        if (!rest.starts_with(literal))
+            return false;
+
+        rest.remove_prefix(literal.size());
+        return true;
+    }
+
+    /// @brief Parse the field at the start of @rest and skip it; text fields end where @until starts,
+    ///        or at the end of @rest if @until is empty
+    template <Scannable T> bool scanField(std::string_view& rest, std::string_view until, T& out)
+    {
+        if constexpr (std::same_as<T, char>) {
+            if (rest.empty())
+                return false;
+
+            out = rest.front();
+            rest.remove_prefix(1U);
+            return true;
+        } else if constexpr (is_scan_text<T>) {
+            const auto length = until.empty() ? rest.size() : rest.find(until);
+            if (length == std::string_view::npos)
+                return false;
+
+            out = T(rest.substr(0U, length));
+            rest.remove_prefix(length);
+            return true;
+        } else {
+            const auto [end, error] = std::from_chars(rest.data(), rest.data() + rest.size(), out);
+            if (error != std::errc {})
+                return false;
+
+            rest.remove_prefix(static_cast<std::size_t>(end - rest.data()));
+            return true;
+        }
+    }
+
+} // namespace detail
+
+/// @brief Match @line against a pattern whose "{}" placeholders are fields of types Ts...,
+///        e.g. scan<"move {} from {} to {}", int, int, int>("move 3 from 5 to 7") gives { 3, 5, 7 }.
+///        The pattern is split at compile time: matching compares fixed literals and parses fields
+///        in place, without allocating (unless a field is a std::string).
+///
+/// @note Integral and floating-point fields are parsed as std::from_chars(); a char field is one character;
+///       std::string_view and std::string fields run up to the next literal of the pattern, or to the end
+///       of the line, and std::string_view fields point into @line
+/// @return the fields, or std::nullopt if @line does not match the whole pattern or a number is out of range
+template <FixedString Pattern, detail::Scannable... Ts>
+std::optional<std::tuple<Ts...>> scan(std::string_view line)
+{
+    using Parts = detail::ScanPattern<Pattern>;
+    static_assert(Parts::fields == sizeof...(Ts), "scan: the pattern needs one {} per field type");
+
+    std::tuple<Ts...> values {};
+    const bool matched = [&]<std::size_t... I>(std::index_sequence<I...>) {
+        static_assert(((!detail::is_scan_text<Ts> || Parts::delimited(I)) && ...),
+            "scan: a text field must be followed by literal text or end the pattern");
+        auto rest = line;
+        return ((detail::scanLiteral(rest, Parts::segments[I])
+                    && detail::scanField(rest, Parts::segments[I + 1U], std::get<I>(values)))
+                   && ...)
+            && rest == Parts::segments.back();
+    }(std::index_sequence_for<Ts...> {});
+
+    if (!matched)
+        return std::nullopt;
+    return values;
+}
+
+/// @brief Fields of the lines parsed by scanLines(), stored as one column per field
+template <template <class> class Allocator, class... Ts> struct BasicScanColumns {
+    std::tuple<std::vector<Ts, Allocator<Ts>>...> columns {};
+    /// Indexes, among the lines produced, of the lines which did not match the pattern
+    std::vector<std::size_t, Allocator<std::size_t>> mismatches {};
+
+    /// @return number of matched lines
+    std::size_t size() const
+    {
+        return std::get<0>(columns).size();
+    }
+
+    template <std::size_t I> const auto& column() const
+    {
+        return std::get<I>(columns);
+    }
+};
+
+template <class... Ts> using ScanColumns = BasicScanColumns<std::allocator, Ts...>;
+
+namespace pmr {
+
+    template <class... Ts> using ScanColumns = BasicScanColumns<std::pmr::polymorphic_allocator, Ts...>;
+
+} // namespace pmr
+
+namespace detail {
+
+    /// @brief Append the fields of every matched line of @buffer to the empty @result, see scanLines()
+    template <FixedString Pattern, class... Ts, class Result>
+    Result scanLinesInto(Result result, std::string_view buffer, LinesOptions options)
+    {
+        const auto expected = static_cast<std::size_t>(std::ranges::count(buffer, '\n')) + 1U;
+        std::apply([&](auto&... column) { (column.reserve(expected), ...); }, result.columns);
+
+        std::size_t index { 0U };
+        for (const auto line : LineRange(buffer, options)) {
+            if (auto values = scan<Pattern, Ts...>(line)) {
+                [&]<std::size_t... I>(std::index_sequence<I...>) {
+                    (std::get<I>(result.columns).push_back(std::move(std::get<I>(*values))), ...);
+                }(std::index_sequence_for<Ts...> {});
+            } else {
+                result.mismatches.push_back(index);
+            }
+            ++index;
+        }
+        return result;
+    }
+
+} // namespace detail
+
+/// @brief scan() every line of @buffer, keeping the fields of matched lines as columns
+///
+/// @param buffer contents to parse, e.g. MappedFile::view(); std::string_view fields point into it
+/// @param options which lines are produced, see LinesOptions
+template <FixedString Pattern, detail::Scannable... Ts>
+ScanColumns<Ts...> scanLines(std::string_view buffer, LinesOptions options = {})
+{
+    static_assert(sizeof...(Ts) > 0U, "scanLines: the pattern needs at least one field");
+    return detail::scanLinesInto<Pattern, Ts...>(ScanColumns<Ts...> {}, buffer, options);
+}
+
+/// @brief scan() every line of @buffer into columns allocated from @resource, see scanLines()
+/// @note Fields which are allocator-aware, e.g. std::string, still use their own allocator
+template <FixedString Pattern, detail::Scannable... Ts>
+pmr::ScanColumns<Ts...> scanLines(std::string_view buffer, std::pmr::memory_resource& resource,
+    LinesOptions options = {})
+{
+    static_assert(sizeof...(Ts) > 0U, "scanLines: the pattern needs at least one field");
+    pmr::ScanColumns<Ts...> result { { std::pmr::vector<Ts>(&resource)... },
+        std::pmr::vector<std::size_t>(&resource) };
+    return detail::scanLinesInto<Pattern, Ts...>(std::move(result), buffer, options);
+}
+
+} // namespace pypp
+
+template <> inline constexpr bool std::ranges::enable_borrowed_range<pypp::SplitRange> = true;
+template <> inline constexpr bool std::ranges::enable_borrowed_range<pypp::LineRange> = true;
+
+namespace collections {
+
+namespace detail {
+
+    /// @brief Finalizer of MurmurHash3: every input bit affects every output bit
+    constexpr std::uint64_t mix64(std::uint64_t x)
+    {
+        x ^= x >> 33U;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33U;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33U;
+        return x;
+    }
+
+    /// @brief Bit mask of the control bytes in a group of 16 which are equal to @value
+    std::uint32_t matchGroup(const std::int8_t* group, std::int8_t value)
+    {
+#if !defined(PYPP_NO_SIMD) && defined(__SSE2__)
+        const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm_set1_epi8(value))));
+#else
+        std::uint32_t mask { 0U };
+        for (unsigned i = 0U; i < 16U; ++i)
+            mask |= static_cast<std::uint32_t>(group[i] == value) << i;
+        return mask;
+#endif
+    }
+
+    /// @brief Bit mask of the control bytes in a group of 16 which are negative (i.e. free slots)
+    std::uint32_t matchFree(const std::int8_t* group)
+    {
+#if !defined(PYPP_NO_SIMD) && defined(__SSE2__)
+        return static_cast<std::uint32_t>(
+            _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(group))));
+#else
+        std::uint32_t mask { 0U };
+        for (unsigned i = 0U; i < 16U; ++i)
+            mask |= static_cast<std::uint32_t>(group[i] < 0) << i;
+        return mask;
+#endif
+    }
+
+    /// @brief Forward iterator over the used slots of a flat container,
+    ///        yielding pairs of references to the key and the value of each slot
+    template <class Container, bool Const> class SlotIterator {
+    public:
+        using container_type = std::conditional_t<Const, const Container, Container>;
+        using mapped_type = typename Container::mapped_type;
+        using mapped_reference = std::conditional_t<Const, const mapped_type&, mapped_type&>;
+        using value_type = std::pair<const typename Container::key_type&, mapped_reference>;
+        using reference = value_type;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+
+        struct pointer {
+            reference ref;
+            const reference* operator->() const
+            {
+                return &ref;
+            }
+        };
+
+        SlotIterator() = default;
+
+        SlotIterator(container_type* container, std::size_t slot)
+            : container_ { container }
+            , slot_ { slot }
+        {
+            skipUnused();
+        }
+
+        operator SlotIterator<Container, true>() const
+            requires(!Const)
+        {
+            return SlotIterator<Container, true>(container_, slot_);
+        }
+
+        reference operator*() const
+        {
+            return { container_->keys_[slot_], container_->values_[slot_] };
+        }
+
+        pointer operator->() const
+        {
+            return { **this };
+        }
+
+        SlotIterator& operator++()
+        {
+            ++slot_;
+            skipUnused();
+            return *this;
+        }
+
+        SlotIterator operator++(int)
+        {
+            auto tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        friend bool operator==(const SlotIterator& lhs, const SlotIterator& rhs)
+        {
+            return lhs.slot_ == rhs.slot_;
+        }
+
+    private:
+        void skipUnused()
+        {
+            while (slot_ < container_->slotCount() && !container_->slotUsed(slot_))
+                ++slot_;
+        }
+
+        container_type* container_ { nullptr };
+        std::size_t slot_ { 0U };
+    };
+
+} // namespace detail
+
+/// @brief Open-addressing hash map with flat, struct-of-arrays storage:
+///        one control byte per slot (7 bits of hash, or empty), then keys and values in parallel arrays.
+///        Slots are probed 16 control bytes at a time.
+///
+/// @note Key and Value must be default-constructible
+/// @note Iterators and references are invalidated by insertions
+template <class Key, class Value, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+class FlatMap {
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using iterator = detail::SlotIterator<FlatMap, false>;
+    using const_iterator = detail::SlotIterator<FlatMap, true>;
+
+    FlatMap() = default;
+
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+    bool empty() const
+    {
+        return size_ == 0U;
+    }
+
+    /// @brief Number of slots, of which at most 7/8 are used before growing
+    std::size_t capacity() const
+    {
+        return ctrl_.size();
+    }
+
+    void clear()
+    {
+        ctrl_.clear();
+        keys_.clear();
+        values_.clear();
+        size_ = 0U;
+        tombstones_ = 0U;
+    }
+
+    /// @brief Remove @key, if present
+    /// @return the number of removed elements (0 or 1)
+    std::size_t erase(const Key& key)
+    {
+        const auto slot = findSlot(key, hashOf(key));
+        if (slot == npos)
+            return 0U;
+
+        eraseSlot(slot);
+        return 1U;
+    }
+
+    /// @brief Remove every element for which @pred(pair of key and value) holds true
+    /// @return the number of removed elements
+    template <class Predicate> friend std::size_t erase_if(FlatMap& map, Predicate pred)
+    {
+        const auto before = map.size_;
+        for (std::size_t slot = 0U; slot < map.ctrl_.size(); ++slot) {
+            const std::pair<const Key&, Value&> item { map.keys_[slot], map.values_[slot] };
+            if (map.ctrl_[slot] >= 0 && pred(item))
+                map.eraseSlot(slot);
+        }
+
+        return before - map.size_;
+    }
+
+    /// @brief Make room for @n elements without further rehashing
+    void reserve(std::size_t n)
+    {
+        std::size_t slots { group_size };
+        while (slots * 7U < n * 8U)
+            slots *= 2U;
+        if (slots > ctrl_.size())
+            rehash(slots);
+    }
+
+    /// @brief Access the value of @key, inserting a value-initialized one if missing
+    Value& operator[](const Key& key)
+    {
+        return emplaceKey(key);
+    }
+    Value& operator[](Key&& key)
+    {
+        return emplaceKey(std::move(key));
+    }
+
+    /// @return a pointer to the value of @key, or nullptr if missing
+    Value* find(const Key& key)
+    {
+        const auto slot = findSlot(key, hashOf(key));
+        return slot == npos ? nullptr : &values_[slot];
+    }
+    const Value* find(const Key& key) const
+    {
+        const auto slot = findSlot(key, hashOf(key));
+        return slot == npos ? nullptr : &values_[slot];
+    }
+
+    bool contains(const Key& key) const
+    {
+        return find(key) != nullptr;
+    }
+
+    iterator begin()
+    {
+        return iterator(this, 0U);
+    }
+    iterator end()
+    {
+        return iterator(this, ctrl_.size());
+    }
+    const_iterator begin() const
+    {
+        return const_iterator(this, 0U);
+    }
+    const_iterator end() const
+    {
+        return const_iterator(this, ctrl_.size());
+    }
+
+private:
+    template <class, bool> friend class detail::SlotIterator;
+
+    static constexpr std::size_t group_size { 16U };
+    static constexpr std::size_t npos { static_cast<std::size_t>(-1) };
+    static constexpr std::int8_t empty_slot { -128 };
+    static constexpr std::int8_t erased_slot { -2 };
+
+    std::size_t slotCount() const
+    {
+        return ctrl_.size();
+    }
+
+    bool slotUsed(std::size_t slot) const
+    {
+        return ctrl_[slot] >= 0;
+    }
+
+    static std::uint64_t hashOf(const Key& key)
+    {
+        return detail::mix64(static_cast<std::uint64_t>(Hash {}(key)));
+    }
+
+    static std::int8_t fingerprint(std::uint64_t h)
+    {
+        return static_cast<std::int8_t>(h >> 57U);
+    }
+
+    std::size_t findSlot(const Key& key, std::uint64_t h) const
+    {
+        if (ctrl_.empty())
+            return npos;
+
+        const auto group_mask = ctrl_.size() / group_size - 1U;
+        const auto tag = fingerprint(h);
+        for (auto g = static_cast<std::size_t>(h) & group_mask, probes = std::size_t { 0U };
+             probes <= group_mask; g = (g + 1U) & group_mask, ++probes) {
+            const auto* group = ctrl_.data() + g * group_size;
+            for (auto match = detail::matchGroup(group, tag); match != 0U; match &= match - 1U) {
+                const auto slot = g * group_size + static_cast<std::size_t>(std::countr_zero(match));
+                if (KeyEqual {}(keys_[slot], key))
+                    return slot;
+            }
+            if (detail::matchGroup(group, empty_slot) != 0U)
+                return npos;
+        }
+
+        return npos;
+    }
+
+    std::size_t freeSlot(std::uint64_t h) const
+    {
+        const auto group_mask = ctrl_.size() / group_size - 1U;
+        for (auto g = static_cast<std::size_t>(h) & group_mask;; g = (g + 1U) & group_mask)
+            if (const auto match = detail::matchFree(ctrl_.data() + g * group_size); match != 0U)
+                return g * group_size + static_cast<std::size_t>(std::countr_zero(match));
+    }
+
+    template <class K> Value& emplaceKey(K&& key)
+    {
+        const auto h = hashOf(key);
+        if (const auto slot = findSlot(key, h); slot != npos)
+            return values_[slot];
+
+        if ((size_ + tombstones_ + 1U) * 8U > ctrl_.size() * 7U) {
+            // grow if mostly full of live elements, otherwise only drop the erased ones
+            const bool grow = (size_ + 1U) * 16U > ctrl_.size() * 7U;
+            rehash(std::max(grow ? ctrl_.size() * 2U : ctrl_.size(), group_size));
+        }
+
+        const auto slot = freeSlot(h);
+        tombstones_ -= ctrl_[slot] == erased_slot;
+        ctrl_[slot] = fingerprint(h);
+        keys_[slot] = std::forward<K>(key);
+        values_[slot] = Value {};
+        ++size_;
+
+        return values_[slot];
+    }
+
+    void eraseSlot(std::size_t slot)
+    {
+        ctrl_[slot] = erased_slot;
+        keys_[slot] = Key {};
+        values_[slot] = Value {};
+        --size_;
+        ++tombstones_;
+    }
+
+    void rehash(std::size_t slots)
+    {
+        tombstones_ = 0U;
+        auto old_ctrl = std::exchange(ctrl_, std::vector<std::int8_t>(slots, empty_slot));
+        auto old_keys = std::exchange(keys_, std::vector<Key>(slots));
+        auto old_values = std::exchange(values_, std::vector<Value>(slots));
+
+        for (std::size_t i = 0U; i < old_ctrl.size(); ++i) {
+            if (old_ctrl[i] < 0)
+                continue;
+            const auto slot = freeSlot(hashOf(old_keys[i]));
+            ctrl_[slot] = old_ctrl[i];
+            keys_[slot] = std::move(old_keys[i]);
+            values_[slot] = std::move(old_values[i]);
+        }
+    }
+
+    std::vector<std::int8_t> ctrl_ {};
+    std::vector<Key> keys_ {};
+    std::vector<Value> values_ {};
+    std::size_t size_ { 0U };
+    std::size_t tombstones_ { 0U };
+};
+
+/// @brief Keys which can index a dense array: integral (except bool) or enumeration types of at most 2 bytes
+template <typename T>
+concept DenseKey = ((std::integral<T> && !std::same_as<T, bool>) || std::is_enum_v<T>) && sizeof(T) <= 2U;
+
+namespace detail {
+
+    /// @brief Histogram of the bytes of a buffer.
+    ///        Four interleaved sub-histograms keep runs of equal bytes from stalling on the same counter,
+    ///        and with @threads != 1, blocks of a few MB are counted on worker threads.
+    ///
+    /// @param threads number of worker threads, 0 means std::thread::hardware_concurrency()
+    std::array<std::uint64_t, 256U> byteHistogram(
+        const unsigned char* data, std::size_t size, unsigned threads)
+    {
+        constexpr std::size_t block_size { 1U << 22U };
+        const auto n_blocks = (size + block_size - 1U) / block_size;
+        std::vector<std::array<std::uint64_t, 256U>> partial(n_blocks);
+
+        pypp::detail::parallelFor(n_blocks, threads, [&](std::size_t block) {
+            std::array<std::array<std::uint32_t, 256U>, 4U> sub {};
+            const auto* first = data + block * block_size;
+            const auto n = std::min(block_size, size - block * block_size);
+            std::size_t i { 0U };
+            for (; i + 4U <= n; i += 4U) {
+                ++sub[0][first[i]];
+                ++sub[1][first[i + 1U]];
+                ++sub[2][first[i + 2U]];
+                ++sub[3][first[i + 3U]];
+            }
+            for (; i < n; ++i)
+                ++sub[0][first[i]];
+
+            for (std::size_t b = 0U; b < 256U; ++b)
+                partial[block][b] = std::uint64_t { sub[0][b] } + sub[1][b] + sub[2][b] + sub[3][b];
+        });
+
+        std::array<std::uint64_t, 256U> histogram {};
+        for (const auto& block : partial)
+            for (std::size_t b = 0U; b < 256U; ++b)
+                histogram[b] += block[b];
+
+        return histogram;
+    }
+
+} // namespace detail
+
+/// @brief Counter storage: node-based std::unordered_map
+template <class Key, class Hash> using NodeStorage = std::unordered_map<Key, int, Hash>;
+
+/// @brief Counter storage: flat open-addressing table, see FlatMap
+template <class Key, class Hash> using FlatStorage = FlatMap<Key, int, Hash>;
+
+/// @brief Counter storage: one count per possible key, in an array indexed by the key itself.
+///        Meant for small-domain keys (char, uint8_t, small enums...), no hashing involved.
+///
+/// @tparam Key integral or enumeration type of at most 2 bytes (65536 slots)
+/// @tparam Hash unused, for interface compatibility
+template <class Key, class Hash> class DenseStorage {
+    static_assert(DenseKey<Key>, "DenseStorage requires an integral or enumeration Key of at most 2 bytes");
+
+public:
+    using key_type = Key;
+    using mapped_type = int;
+    using iterator = detail::SlotIterator<DenseStorage, false>;
+    using const_iterator = detail::SlotIterator<DenseStorage, true>;
+
+    DenseStorage()
+        : keys_(domain)
+        , values_(domain, 0)
+        , used_(domain, false)
+    {
+        for (std::size_t i = 0U; i < domain; ++i)
+            keys_[i] = static_cast<Key>(static_cast<index_type>(i));
+    }
+
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+    bool empty() const
+    {
+        return size_ == 0U;
+    }
+
+    void clear()
+    {
+        std::fill(values_.begin(), values_.end(), 0);
+        std::fill(used_.begin(), used_.end(), false);
+        size_ = 0U;
+    }
+
+    int& operator[](const Key& key)
+    {
+        const auto i = indexOf(key);
+        if (!used_[i]) {
+            used_[i] = true;
+            ++size_;
+        }
+        return values_[i];
+    }
+
+    int* find(const Key& key)
+    {
+        const auto i = indexOf(key);
+        return used_[i] ? &values_[i] : nullptr;
+    }
+    const int* find(const Key& key) const
+    {
+        const auto i = indexOf(key);
+        return used_[i] ? &values_[i] : nullptr;
+    }
+
+    bool contains(const Key& key) const
+    {
+        return used_[indexOf(key)];
+    }
+
+    /// @brief Remove @key, if present
+    /// @return the number of removed elements (0 or 1)
+    std::size_t erase(const Key& key)
+    {
+        const auto i = indexOf(key);
+        if (!used_[i])
+            return 0U;
+
+        used_[i] = false;
+        values_[i] = 0;
+        --size_;
+        return 1U;
+    }
+
+    /// @brief Remove every element for which @pred(pair of key and count) holds true
+    /// @return the number of removed elements
+    template <class Predicate> friend std::size_t erase_if(DenseStorage& storage, Predicate pred)
+    {
+        const auto before = storage.size_;
+        for (std::size_t i = 0U; i < domain; ++i) {
+            const std::pair<const Key&, int&> item { storage.keys_[i], storage.values_[i] };
+            if (storage.used_[i] && pred(item))
+                storage.erase(storage.keys_[i]);
+        }
+
+        return before - storage.size_;
+    }
+
+    /// @brief Count every key of [@first, @last)
+    ///        Contiguous ranges of 1-byte keys are counted with detail::byteHistogram()
+    ///
+    /// @param threads worker threads counting contiguous ranges of 1-byte keys, 0 means
+    ///        std::thread::hardware_concurrency(); other ranges are counted on the calling thread
+    /// @throw std::overflow_error if a count would exceed std::numeric_limits<int>::max(), in which case
+    ///        no count is changed
+    template <class InputIt> void addRange(InputIt first, InputIt last, unsigned threads = 1U)
+    {
+        if constexpr (std::contiguous_iterator<InputIt> && sizeof(Key) == 1U
+            && std::is_same_v<std::iter_value_t<InputIt>, Key>) {
+            const auto* data = reinterpret_cast<const unsigned char*>(std::to_address(first));
+            const auto histogram
+                = detail::byteHistogram(data, static_cast<std::size_t>(last - first), threads);
+            constexpr auto max_count = static_cast<std::uint64_t>(std::numeric_limits<int>::max());
+            for (std::size_t i = 0U; i < domain; ++i)
+                if (histogram[i] > max_count - static_cast<std::uint64_t>(std::max(values_[i], 0)))
+                    throw std::overflow_error("DenseStorage: count does not fit in an int");
+            for (std::size_t i = 0U; i < domain; ++i)
+                if (histogram[i] != 0U)
+                    (*this)[keys_[i]] += static_cast<int>(histogram[i]);
+        } else {
+            for (; first != last; ++first)
+                (*this)[*first] += 1;
+        }
+    }
+
+    iterator begin()
+    {
+        return iterator(this, 0U);
+    }
+    iterator end()
+    {
+        return iterator(this, domain);
+    }
+    const_iterator begin() const
+    {
+        return const_iterator(this, 0U);
+    }
+    const_iterator end() const
+    {
+        return const_iterator(this, domain);
+    }
+
+private:
+    template <class, bool> friend class detail::SlotIterator;
+
+    using integral_type = typename std::conditional_t<std::is_enum_v<Key>, std::underlying_type<Key>,
+        std::type_identity<Key>>::type;
+    using index_type = std::make_unsigned_t<integral_type>;
+    static constexpr std::size_t domain { std::size_t { 1U } << (8U * sizeof(Key)) };
+
+    static std::size_t indexOf(const Key& key)
+    {
+        return static_cast<index_type>(key);
+    }
+
+    std::size_t slotCount() const
+    {
+        return domain;
+    }
+
+    bool slotUsed(std::size_t slot) const
+    {
+        return used_[slot];
+    }
+
+    std::vector<Key> keys_ {};
+    std::vector<int> values_ {};
+    std::vector<bool> used_ {};
+    std::size_t size_ { 0U };
+};
+
+/// @brief Counter storage picked by default: DenseStorage for 1-byte keys, NodeStorage otherwise
+template <class Key, class Hash>
+using DefaultStorage
+    = std::conditional_t<DenseKey<Key> && sizeof(Key) == 1U, DenseStorage<Key, Hash>, NodeStorage<Key, Hash>>;
+
+/// @brief A collection of key-value pairs, where:
+///        - elements [Generic] are stored as <Keys>
+///        - element counts [int] are stored as <Values>
+///
+/// @tparam Storage map template from Key to int: NodeStorage, FlatStorage or DenseStorage
+template <class Key, class Hash = std::hash<Key>, template <class, class> class Storage = DefaultStorage>
+class Counter {
+public:
+    using storage_type = Storage<Key, Hash>;
+
+    Counter() = default;
+
+    template <class InputIt> Counter(InputIt first, InputIt last)
+        : Counter(first, last, 1U)
+    {
+    }
+
+    /// @brief Count [@first, @last) on up to @threads worker threads where the storage supports it,
+    ///        i.e. contiguous ranges of 1-byte keys in DenseStorage, and on the calling thread otherwise
+    ///
+    /// @param threads number of worker threads, 0 means std::thread::hardware_concurrency()
+    template <class InputIt> Counter(InputIt first, InputIt last, unsigned threads)
+    {
+        if constexpr (requires { storage_.addRange(first, last, threads); }) {
+            storage_.addRange(first, last, threads);
+        } else {
+            for (; first != last; ++first) {
+                storage_[*first] += 1;
+            }
+        }
+    }
+
+    Counter(const Counter& other) = default;
+
+    Counter& operator=(const Counter& other) = default;
+
+    Counter(Counter&& other) = default;
+
+    Counter& operator=(Counter&& other) = default;
+
+    /// @brief (Psuedo-) copy-constructor
+    ///        Implicit conversion from std::unordered_map<Key, int> -> Counter is allowed
+    template <class T> Counter(const std::unordered_map<T, int>& other_map)
+    {
+        static_assert(std::is_same_v<Key, T> == true,
+            "Assignment Error: Can not construct Counter from incompatible Key type: {}");
+
+        assign(other_map);
+    }
+
+    /// @brief (Psuedo-) copy-assignment
+    ///        Implicit conversion from std::unordered_map<Key, int> -> Counter is allowed
+    template <class T> Counter& operator=(const std::unordered_map<T, int>& other_map)
+    {
+        static_assert(std::is_same_v<Key, T> == true,
+            "Assignment Error: Can not assing to Counter from incompatible Key type: {}");
+        // @note, possible TODO : cannot check for equality to existing map;
+        // would need to overload operator==
+
+        assign(other_map);
+        return *this;
+    }
+
+    /// @brief Retrieve a copy of the counts as a std::unordered_map
+    std::unordered_map<Key, int, Hash> getUnderlyingMap() const
+    {
+        if constexpr (std::is_same_v<storage_type, std::unordered_map<Key, int, Hash>>)
+            return storage_;
+        else
+            return std::unordered_map<Key, int, Hash>(storage_.begin(), storage_.end());
+    }
+
+    /// @brief Retrieve the underlying storage, without copying it
+    const storage_type& storage() const
+    {
+        return storage_;
+    }
+
+    /// @brief Number of distinct keys
+    std::size_t size() const
+    {
+        return storage_.size();
+    }
+
+    /// @brief Whether there are no keys
+    bool empty() const
+    {
+        return storage_.empty();
+    }
+
+    /// @brief Access the count of a key, inserting it with a count of 0 if missing
+    ///
+    /// @note Return value is reference to int (int&) to allow to modify it
+    /// @note Complexity:
+    ///       - avg: constant
+    ///       - woc: linear in size
+    ///
+    /// @param key
+    int& operator[](const Key& key)
+    {
+        return storage_[key];
+    }
+    int& operator[](Key&& key)
+    {
+        return storage_[std::move(key)];
+    }
+
+    /// @brief Return a view of the keys
+    ///
+    /// @return A range of const Key&, referring into the storage
+    auto keys() const
+    {
+        return storage_ | std::views::transform([](const auto& pair) -> const Key& { return pair.first; });
+    }
+
+    /// @brief Return a view of the counts
+    ///
+    /// @return A range of int&, referring into the storage
+    auto values()
+    {
+        return storage_ | std::views::transform([](auto&& pair) -> int& { return pair.second; });
+    }
+    auto values() const
+    {
+        return storage_ | std::views::transform([](const auto& pair) -> const int& { return pair.second; });
+    }
+
+    /// @brief Return a view of the keys and counts
+    ///
+    /// @return A range of pairs whose members `first` and `second` refer to a key and its count
+    auto items()
+    {
+        return std::views::all(storage_);
+    }
+    auto items() const
+    {
+        return std::views::all(storage_);
+    }
+
+    /// @brief Lazy range over the elements, repeating each key as many times as its count
+    class ElementsView : public std::ranges::view_interface<ElementsView> {
+    public:
+        class iterator {
+        public:
+            using storage_iterator = typename storage_type::const_iterator;
+            using iterator_concept = std::forward_iterator_tag;
+            using iterator_category = std::input_iterator_tag;
+            using value_type = Key;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+
+            iterator(storage_iterator it, storage_iterator last)
+                : it_ { it }
+                , last_ { last }
+            {
+                skipNonPositive();
+            }
+
+            const Key& operator*() const
+            {
+                return (*it_).first;
+            }
+
+            iterator& operator++()
+            {
+                if (++repeat_ >= (*it_).second) {
+                    ++it_;
+                    repeat_ = 0;
+                    skipNonPositive();
+                }
+                return *this;
+            }
+
+            iterator operator++(int)
+            {
+                auto tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            friend bool operator==(const iterator& lhs, const iterator& rhs)
+            {
+                return lhs.it_ == rhs.it_ && lhs.repeat_ == rhs.repeat_;
+            }
+
+        private:
+            void skipNonPositive()
+            {
+                while (it_ != last_ && (*it_).second < 1)
+                    ++it_;
+            }
+
+            storage_iterator it_ {};
+            storage_iterator last_ {};
+            int repeat_ { 0 };
+        };
+
+        ElementsView() = default;
+
+        explicit ElementsView(const storage_type& storage)
+            : storage_ { &storage }
+        {
+        }
+
+        iterator begin() const
+        {
+            return iterator(storage_->begin(), storage_->end());
+        }
+
+        iterator end() const
+        {
+            return iterator(storage_->end(), storage_->end());
+        }
+
+    private:
+        const storage_type* storage_ { nullptr };
+    };
+
+    /// @brief Return a lazy range over elements, repeating each as many time as its count.
+    /// @note If an element's count is < 1 it is ignored
+    /// @note Elements are grouped by key, in storage order
+    ///
+    /// @return A range of const Key&, referring into the storage
+    ElementsView elements() const
+    {
+        return ElementsView(storage_);
+    }
+
+    /// @brief Return the `n` most common elements and their counts sorted by most to least common.
+    ///        Equal counts are sorted by ascending key, if keys are ordered.
+    ///
+    /// @param n Max number of elements returned
+    /// @return A std::vector of std::pair<Key, int> representing the elements and their corresponding counts
+    /// @note By default returns all elements in the Counter
+    /// @note Complexity: O(size * log(n)) time, O(n) extra memory
+    std::vector<std::pair<Key, int>> mostCommon(std::size_t n = 0) const
+    {
+        return mostCommonInto(std::vector<std::pair<Key, int>> {}, n);
+    }
+
+    /// @brief Return the `n` most common elements, in a vector allocated from @resource, see mostCommon()
+    /// @note Elements which are allocator-aware, e.g. std::string keys, still use their own allocator
+    std::pmr::vector<std::pair<Key, int>> mostCommon(
+        std::pmr::memory_resource& resource, std::size_t n = 0) const
+    {
+        return mostCommonInto(std::pmr::vector<std::pair<Key, int>> { &resource }, n);
+    }
+
+    /// @brief Return the sum of all counts.
+    ///
+    /// @return The sum of all counts
+    int total() const
+    {
+        if (storage_.empty())
+            return 0;
+
+        int sum { 0 };
+        for (const auto& pair : storage_)
+            sum += pair.second;
+
+        return sum;
+    }
+
+    /// @brief Count every element of [@first, @last) on top of the current counts
+    template <class InputIt> void update(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first)
+            storage_[*first] += 1;
+    }
+
+    /// @brief Add the counts of @other to the current counts
+    void update(const Counter& other)
+    {
+        for (const auto& [key, count] : other.storage_)
+            storage_[key] += count;
+    }
+
+    /// @brief Add the counts of @other to the current counts,
+    ///        reusing the storage of whichever of the two is larger
+    void update(Counter&& other)
+    {
+        if (other.size() > size())
+            std::swap(storage_, other.storage_);
+        update(std::as_const(other));
+    }
+
+    /// @brief Subtract one for every element of [@first, @last), counts can become zero or negative
+    template <class InputIt> void subtract(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first)
+            storage_[*first] -= 1;
+    }
+
+    /// @brief Subtract the counts of @other, counts can become zero or negative
+    void subtract(const Counter& other)
+    {
+        for (const auto& [key, count] : other.storage_)
+            storage_[key] -= count;
+    }
+
+    /// @brief Add the counts of @other, then keep only positive counts
+    Counter& operator+=(const Counter& other)
+    {
+        update(other);
+        return keepPositive();
+    }
+    Counter& operator+=(Counter&& other)
+    {
+        update(std::move(other));
+        return keepPositive();
+    }
+
+    /// @brief Subtract the counts of @other, then keep only positive counts
+    Counter& operator-=(const Counter& other)
+    {
+        subtract(other);
+        return keepPositive();
+    }
+
+    /// @brief Union: the max of both counts for each key, then keep only positive counts
+    Counter& operator|=(const Counter& other)
+    {
+        for (const auto& [key, count] : other.storage_) {
+            auto& own = storage_[key];
+            own = std::max(own, count);
+        }
+        return keepPositive();
+    }
+
+    /// @brief Intersection: the min of both counts for each key, then keep only positive counts
+    Counter& operator&=(const Counter& other)
+    {
+        for (auto&& [key, count] : storage_)
+            count = std::min(count, other.countOf(key));
+        return keepPositive();
+    }
+
+    friend Counter operator+(Counter lhs, const Counter& rhs)
+    {
+        return std::move(lhs += rhs);
+    }
+
+    friend Counter operator-(Counter lhs, const Counter& rhs)
+    {
+        return std::move(lhs -= rhs);
+    }
+
+    friend Counter operator|(Counter lhs, const Counter& rhs)
+    {
+        return std::move(lhs |= rhs);
+    }
+
+    friend Counter operator&(Counter lhs, const Counter& rhs)
+    {
+        return std::move(lhs &= rhs);
+    }
+
+    /// @brief Sum many partial counters, merging them pairwise in a parallel tree:
+    ///        log2(size) rounds, the merges of each round running on worker threads
+    ///
+    /// @param counters the partial counters, consumed
+    /// @param threads number of worker threads, 0 means std::thread::hardware_concurrency()
+    /// @return a Counter with the sum of all counts, as update() would compute
+    static Counter reduce(std::vector<Counter> counters, unsigned threads = 0U)
+    {
+        if (counters.empty())
+            return Counter {};
+
+        for (std::size_t stride = 1U; stride < counters.size(); stride *= 2U) {
+            const auto n_merges = (counters.size() - stride + 2U * stride - 1U) / (2U * stride);
+            pypp::detail::parallelFor(n_merges, threads, [&](std::size_t k) {
+                const auto i = 2U * stride * k;
+                counters[i].update(std::move(counters[i + stride]));
+                counters[i + stride] = Counter {};
+            });
+        }
+
+        return std::move(counters.front());
+    }
+
+    // for debugging purposes
+    void pprint()
+    {
+        std::cout << "-----" << std::endl;
+        for (const auto& elem : storage_)
+            std::cout << elem.first << ": " << elem.second << std::endl;
+        std::cout << "-----" << std::endl;
+    }
+
+private:
+    /// @brief Fill the empty vector @t_v with the @n most common elements, see mostCommon()
+    template <class Pairs> Pairs mostCommonInto(Pairs t_v, std::size_t n) const
+    {
+        const auto before = [](const auto& lhs, const auto& rhs) {
+            if (lhs.second != rhs.second)
+                return lhs.second > rhs.second;
+            if constexpr (std::totally_ordered<Key>)
+                return lhs.first < rhs.first;
+            else
+                return false;
+        };
+
+        if (n == 0 || n >= storage_.size()) {
+            t_v.reserve(storage_.size());
+            for (const auto& pair : storage_)
+                t_v.emplace_back(pair.first, pair.second);
+
+            std::sort(std::begin(t_v), std::end(t_v), before);
+            return t_v;
+        }
+
+        // bounded heap of the n best pairs so far, the worst of them on top
+        t_v.reserve(n);
+        for (const auto& pair : storage_) {
+            if (t_v.size() < n) {
+                t_v.emplace_back(pair.first, pair.second);
+                std::push_heap(std::begin(t_v), std::end(t_v), before);
+            } else if (before(pair, t_v.front())) {
+                std::pop_heap(std::begin(t_v), std::end(t_v), before);
+                t_v.back() = { pair.first, pair.second };
+                std::push_heap(std::begin(t_v), std::end(t_v), before);
+            }
+        }
+
+        std::sort_heap(std::begin(t_v), std::end(t_v), before);
+        return t_v;
+    }
+
+    /// @brief Count of @key, 0 if missing, without inserting it
+    int countOf(const Key& key) const
+    {
+        const auto found = storage_.find(key);
+        if constexpr (std::is_pointer_v<decltype(found)>)
+            return found == nullptr ? 0 : *found;
+        else
+            return found == storage_.end() ? 0 : found->second;
+    }
+
+    Counter& keepPositive()
+    {
+        using std::erase_if;
+        erase_if(storage_, [](const auto& item) { return item.second <= 0; });
+        return *this;
+    }
+
+    template <class Map> void assign(const Map& other_map)
+    {
+        if constexpr (std::is_assignable_v<storage_type&, const Map&>) {
+            storage_ = other_map;
+        } else {
+            storage_.clear();
+            for (const auto& [key, count] : other_map)
+                storage_[key] = count;
+        }
+    }
+
+    storage_type storage_ {};
+};
+
+/// @brief Counter of interned tokens, keyed by their pypp::Interner ids, e.g. built from pypp::splitIds()
+using IdCounter = Counter<pypp::Interner::id_type, std::hash<pypp::Interner::id_type>, FlatStorage>;
+
+/// @brief Translate a Counter of interned ids back into a Counter of strings
+///
+/// @param counts counts keyed by ids of @interner
+/// @param interner table which produced the ids
+template <class Hash, template <class, class> class Storage>
+Counter<std::string> resolveIds(
+    const Counter<pypp::Interner::id_type, Hash, Storage>& counts, const pypp::Interner& interner)
+{
+    Counter<std::string> result {};
+    for (const auto& [id, count] : counts.items())
+        result[std::string(interner[id])] = count;
+
+    return result;
+}
+
+/// @brief A Counter which can be updated from several threads at once.
+///        Keys are spread by hash over lock-striped shards, each of them a Counter behind its own mutex.
+///        For hot, shared keys prefer writer(): it counts into a thread-local Counter and merges it
+///        into the shards in batches.
+template <class Key, class Hash = std::hash<Key>, template <class, class> class Storage = DefaultStorage>
+class ConcurrentCounter {
+public:
+    using counter_type = Counter<Key, Hash, Storage>;
+
+    /// @brief Thread-local handle buffering increments, merged into the shared counter
+    ///        once @flush_at distinct keys are buffered, on flush() and on destruction
+    /// @note The destructor cannot report a failed merge (e.g. std::bad_alloc), and drops the buffered
+    ///       increments instead: call flush() first to observe such errors
+    class Writer {
+    public:
+        explicit Writer(ConcurrentCounter& target, std::size_t flush_at = 4096U)
+            : target_ { &target }
+            , flush_at_ { flush_at }
+        {
+        }
+
+        Writer(const Writer& other) = delete;
+
+        Writer& operator=(const Writer& other) = delete;
+
+        Writer(Writer&& other) noexcept
+            : target_ { std::exchange(other.target_, nullptr) }
+            , flush_at_ { other.flush_at_ }
+            , local_ { std::move(other.local_) }
+        {
+        }
+
+        Writer& operator=(Writer&& other) = delete;
+
+        ~Writer()
+        {
+            try {
+                flush();
+            } catch (...) {
+                // destructors must not throw, see the note above
+            }
+        }
+
+        void add(const Key& key, int n = 1)
+        {
+            local_[key] += n;
+            if (local_.size() >= flush_at_)
+                flush();
+        }
+
+        void flush()
+        {
+            if (target_ != nullptr && !local_.empty()) {
+                target_->merge(local_);
+                local_ = counter_type {};
+            }
+        }
+
+    private:
+        ConcurrentCounter* target_ { nullptr };
+        std::size_t flush_at_ { 0U };
+        counter_type local_ {};
+    };
+
+    /// @param shards number of lock stripes, rounded up to a power of two
+    explicit ConcurrentCounter(std::size_t shards = 64U)
+        : n_shards_ { std::bit_ceil(std::max<std::size_t>(shards, 1U)) }
+        , shards_ { std::make_unique<Shard[]>(n_shards_) }
+    {
+    }
+
+    ConcurrentCounter(const ConcurrentCounter& other) = delete;
+
+    ConcurrentCounter& operator=(const ConcurrentCounter& other) = delete;
+
+    /// @brief Add @n to the count of @key
+    void add(const Key& key, int n = 1)
+    {
+        auto& shard = shards_[shardOf(key)];
+        const std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.counter[key] += n;
+    }
+
+    /// @brief Add every count of @other
+    void merge(const counter_type& other)
+    {
+        std::vector<std::vector<std::pair<const Key*, int>>> per_shard(n_shards_);
+        for (const auto& [key, count] : other.items())
+            per_shard[shardOf(key)].emplace_back(&key, count);
+
+        for (std::size_t i = 0U; i < n_shards_; ++i) {
+            if (per_shard[i].empty())
+                continue;
+            const std::lock_guard<std::mutex> lock(shards_[i].mutex);
+            for (const auto& [key, count] : per_shard[i])
+                shards_[i].counter[*key] += count;
+        }
+    }
+
+    /// @brief Add every count of @other, which may be concurrently updated
+    void merge(const ConcurrentCounter& other)
+    {
+        if (&other != this)
+            merge(other.snapshot());
+    }
+
+    /// @brief Return a Writer, to be used by a single thread
+    Writer writer(std::size_t flush_at = 4096U)
+    {
+        return Writer(*this, flush_at);
+    }
+
+    /// @brief Copy the counts into a regular Counter
+    /// @note Shards are copied one after the other: updates running concurrently
+    ///       may be partially included
+    counter_type snapshot() const
+    {
+        counter_type result {};
+        for (std::size_t i = 0U; i < n_shards_; ++i) {
+            const std::lock_guard<std::mutex> lock(shards_[i].mutex);
+            for (const auto& [key, count] : shards_[i].counter.items())
+                result[key] += count;
+        }
+        return result;
+    }
+
+    /// @brief Return the sum of all counts.
+    int total() const
+    {
+        int sum { 0 };
+        for (std::size_t i = 0U; i < n_shards_; ++i) {
+            const std::lock_guard<std::mutex> lock(shards_[i].mutex);
+            sum += shards_[i].counter.total();
+        }
+        return sum;
+    }
+
+private:
+    struct alignas(64) Shard {
+        mutable std::mutex mutex {};
+        counter_type counter {};
+    };
+
+    /// @brief Shard of @key, from the high bits of its hash: FlatMap shards pick home groups
+    ///        from the low bits, which would otherwise be the same for every key of a shard
+    std::size_t shardOf(const Key& key) const
+    {
+        if (n_shards_ == 1U)
+            return 0U;
+
+        const auto h = detail::mix64(static_cast<std::uint64_t>(Hash {}(key)));
+        return static_cast<std::size_t>(h >> (64 - std::countr_zero(n_shards_)));
+    }
+
+    std::size_t n_shards_ { 0U };
+    std::unique_ptr<Shard[]> shards_ {};
+};
+
+/// @brief Approximate Counter for unbounded streams, tracking at most `capacity` keys
+///        (Space-Saving, Metwally et al. 2005). When a new key arrives and the table is full,
+///        it replaces the key with the lowest count and inherits that count as its error.
+///
+/// Error bounds, with N = total() and k = capacity():
+///  - a key is overestimated by at most error(key) <= N / k: true count in [count - error(key), count]
+///  - every key whose true count exceeds N / k is tracked, so mostCommon(n) finds all of them
+///  - untracked keys report a count of 0, their true count is at most minCount() <= N / k
+///
+/// @note Memory is O(k), regardless of the number of distinct keys in the stream
+template <class Key, class Hash = std::hash<Key>> class SpaceSaving {
+public:
+    explicit SpaceSaving(std::size_t capacity)
+        : capacity_ { std::max<std::size_t>(capacity, 1U) }
+    {
+        heap_.reserve(capacity_);
+        index_.reserve(capacity_);
+    }
+
+    template <class InputIt>
+    SpaceSaving(std::size_t capacity, InputIt first, InputIt last)
+        : SpaceSaving(capacity)
+    {
+        for (; first != last; ++first)
+            add(*first);
+    }
+
+    /// @brief Count @n more occurrences of @key, @n > 0
+    void add(const Key& key, std::int64_t n = 1)
+    {
+        total_ += n;
+
+        if (const auto it = index_.find(key); it != index_.end()) {
+            heap_[it->second].count += n;
+            siftDown(it->second);
+        } else if (heap_.size() < capacity_) {
+            heap_.push_back({ key, n, 0 });
+            index_.emplace(key, heap_.size() - 1U);
+            siftUp(heap_.size() - 1U);
+        } else {
+            auto& evicted = heap_.front();
+            index_.erase(evicted.key);
+            evicted = { key, evicted.count + n, evicted.count };
+            index_.emplace(key, 0U);
+            siftDown(0U);
+        }
+    }
+
+    /// @brief Estimated count of @key, never below its true count if tracked, 0 if untracked
+    std::int64_t operator[](const Key& key) const
+    {
+        const auto it = index_.find(key);
+        return it == index_.end() ? 0 : heap_[it->second].count;
+    }
+
+    /// @brief Max overestimation of the count of @key
+    std::int64_t error(const Key& key) const
+    {
+        const auto it = index_.find(key);
+        return it == index_.end() ? minCount() : heap_[it->second].error;
+    }
+
+    /// @brief Lowest tracked count, an upper bound of the count of any untracked key
+    std::int64_t minCount() const
+    {
+        return heap_.size() < capacity_ ? 0 : heap_.front().count;
+    }
+
+    /// @brief Return the `n` keys with the highest estimated counts, sorted by most to least common.
+    ///        Equal counts are sorted by ascending key, if keys are ordered.
+    ///
+    /// @param n Max number of elements returned
+    /// @note By default returns all tracked keys
+    std::vector<std::pair<Key, std::int64_t>> mostCommon(std::size_t n = 0) const
+    {
+        std::vector<std::pair<Key, std::int64_t>> result {};
+        result.reserve(heap_.size());
+        for (const auto& entry : heap_)
+            result.emplace_back(entry.key, entry.count);
+
+        const auto before = [](const auto& lhs, const auto& rhs) {
+            if (lhs.second != rhs.second)
+                return lhs.second > rhs.second;
+            if constexpr (std::totally_ordered<Key>)
+                return lhs.first < rhs.first;
+            else
+                return false;
+        };
+        const auto n_kept = (n == 0 || n > result.size()) ? result.size() : n;
+        std::partial_sort(result.begin(), result.begin() + n_kept, result.end(), before);
+        result.resize(n_kept);
+
+        return result;
+    }
+
+    /// @brief Return the exact sum of all counts.
+    std::int64_t total() const
+    {
+        return total_;
+    }
+
+    /// @brief Number of tracked keys
+    std::size_t size() const
+    {
+        return heap_.size();
+    }
+
+    std::size_t capacity() const
+    {
+        return capacity_;
+    }
+
+private:
+    struct Entry {
+        Key key;
+        std::int64_t count;
+        std::int64_t error;
+    };
+
+    void swapEntries(std::size_t i, std::size_t j)
+    {
+        std::swap(heap_[i], heap_[j]);
+        index_[heap_[i].key] = i;
+        index_[heap_[j].key] = j;
+    }
+
+    void siftUp(std::size_t i)
+    {
+        for (; i > 0U && heap_[i].count < heap_[(i - 1U) / 2U].count; i = (i - 1U) / 2U)
+            swapEntries(i, (i - 1U) / 2U);
+    }
+
+    void siftDown(std::size_t i)
+    {
+        for (;;) {
+            auto smallest = i;
+            for (const auto child : { 2U * i + 1U, 2U * i + 2U })
+                if (child < heap_.size() && heap_[child].count < heap_[smallest].count)
+                    smallest = child;
+            if (smallest == i)
+                return;
+            swapEntries(i, smallest);
+            i = smallest;
+        }
+    }
+
+    std::size_t capacity_ { 0U };
+    std::int64_t total_ { 0 };
+    std::vector<Entry> heap_ {};
+    std::unordered_map<Key, std::size_t, Hash> index_ {};
+};
+
+/// @brief Fixed-memory frequency estimator (Count-Min Sketch, Cormode & Muthukrishnan 2005):
+///        `depth` rows of `width` counters, each key adds to one counter per row.
+///
+/// Error bounds, with N = total(): the estimate of a key is never below its true count, and
+/// exceeds it by more than e / width * N with probability at most exp(-depth).
+/// withErrorBounds(epsilon, delta) sizes the sketch for an error of epsilon * N with probability 1 - delta.
+template <class Key, class Hash = std::hash<Key>> class CountMinSketch {
+public:
+    CountMinSketch(std::size_t width, std::size_t depth)
+        : width_ { std::max<std::size_t>(width, 1U) }
+        , depth_ { std::max<std::size_t>(depth, 1U) }
+        , table_(width_ * depth_, 0)
+    {
+    }
+
+    /// @throw std::invalid_argument unless @epsilon > 0 and 0 < @delta < 1
+    static CountMinSketch withErrorBounds(double epsilon, double delta)
+    {
+        if (!(epsilon > 0.0))
+            throw std::invalid_argument("CountMinSketch: epsilon must be positive");
+        if (!(delta > 0.0 && delta < 1.0))
+            throw std::invalid_argument("CountMinSketch: delta must be in (0, 1)");
+        return CountMinSketch(static_cast<std::size_t>(std::ceil(std::exp(1.0) / epsilon)),
+            static_cast<std::size_t>(std::ceil(std::log(1.0 / delta))));
+    }
+
+    /// @brief Count @n more occurrences of @key, @n > 0
+    void add(const Key& key, std::int64_t n = 1)
+    {
+        total_ += n;
+        const auto [h1, h2] = hashesOf(key);
+        for (std::size_t row = 0U; row < depth_; ++row)
+            table_[row * width_ + (h1 + row * h2) % width_] += n;
+    }
+
+    /// @brief Estimated count of @key, never below its true count
+    std::int64_t operator[](const Key& key) const
+    {
+        const auto [h1, h2] = hashesOf(key);
+        auto estimate = std::numeric_limits<std::int64_t>::max();
+        for (std::size_t row = 0U; row < depth_; ++row)
+            estimate = std::min(estimate, table_[row * width_ + (h1 + row * h2) % width_]);
+        return estimate;
+    }
+
+    /// @brief Return the exact sum of all counts.
+    std::int64_t total() const
+    {
+        return total_;
+    }
+
+    std::size_t width() const
+    {
+        return width_;
+    }
+
+    std::size_t depth() const
+    {
+        return depth_;
+    }
+
+private:
+    static std::pair<std::uint64_t, std::uint64_t> hashesOf(const Key& key)
+    {
+        const auto h = detail::mix64(static_cast<std::uint64_t>(Hash {}(key)));
+        return { h, detail::mix64(h ^ 0x9e3779b97f4a7c15ULL) | 1U };
+    }
+
+    std::size_t width_ { 0U };
+    std::size_t depth_ { 0U };
+    std::vector<std::int64_t> table_ {};
+    std::int64_t total_ { 0 };
+};
+
+/// @brief Monotone priority queue over unsigned keys (radix heap, Ahuja et al. 1990): the key of a pushed
+///        value must not be smaller than the key last popped, as in Dijkstra's algorithm.
+///
+///        Values are kept in 33 buckets by the highest bit in which their key differs from the last popped
+///        one; popping redistributes the first non-empty bucket, so that each value moves O(log C) times
+///        for keys spread over a range of C, with no comparison-based sift.
+template <class Value> class RadixHeap {
+public:
+    using key_type = std::uint32_t;
+
+    bool empty() const
+    {
+        return size_ == 0U;
+    }
+
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+    /// @throw std::invalid_argument if @key is smaller than the last popped key
+    void push(key_type key, Value value)
+    {
+        if (key < last_)
+            throw std::invalid_argument("RadixHeap: key smaller than the last popped key");
+        const auto bucket = bucketOf(key);
+        buckets_[bucket].emplace_back(key, std::move(value));
+        mins_[bucket] = std::min(mins_[bucket], key);
+        ++size_;
+    }
+
+    /// @return the smallest key
+    /// @throw std::out_of_range if the heap is empty
+    key_type topKey()
+    {
+        refill();
+        return last_;
+    }
+
+    /// @brief Remove a value of smallest key
+    /// @return the key and the value
+    /// @throw std::out_of_range if the heap is empty
+    std::pair<key_type, Value> pop()
+    {
+        refill();
+        auto entry = std::move(buckets_[0].back());
+        buckets_[0].pop_back();
+        --size_;
+        return entry;
+    }
+
+    /// @brief Remove all values and accept any key again
+    void clear()
+    {
+        for (auto& bucket : buckets_)
+            bucket.clear();
+        mins_.fill(std::numeric_limits<key_type>::max());
+        size_ = 0U;
+        last_ = 0U;
+    }
+
+private:
+    std::size_t bucketOf(key_type key) const
+    {
+        return static_cast<std::size_t>(std::bit_width(key ^ last_));
+    }
+
+    static constexpr std::array<key_type, 33U> filledMins()
+    {
+        std::array<key_type, 33U> mins {};
+        mins.fill(std::numeric_limits<key_type>::max());
+        return mins;
+    }
+
+    /// @brief Make bucket 0 hold the values of smallest key
+    void refill()
+    {
+        if (!buckets_[0].empty())
+            return;
+        if (size_ == 0U)
+            throw std::out_of_range("RadixHeap: empty heap");
+
+        std::size_t i { 1U };
+        while (buckets_[i].empty())
+            ++i;
+        auto& bucket = buckets_[i];
+        last_ = mins_[i];
+        mins_[i] = std::numeric_limits<key_type>::max();
+        for (auto& entry : bucket) {
+            const auto target = bucketOf(entry.first);
+            mins_[target] = std::min(mins_[target], entry.first);
+            buckets_[target].push_back(std::move(entry));
+        }
+        bucket.clear();
+    }
+
+    std::array<std::vector<std::pair<key_type, Value>>, 33U> buckets_ {};
+    /// smallest key of each bucket
+    std::array<key_type, 33U> mins_ { filledMins() };
+    std::size_t size_ { 0U };
+    key_type last_ { 0U };
+};
+
+template<typename T>
+concept TupleLike = requires (T t)
+{
+    typename std::tuple_size<T>::type;
+    std::get<0>(t);
+};
+
+/// @brief Two integral (or enumeration) elements of at most 32 bits, which fit in a single 64-bit key
+template<typename T>
+concept PackablePair = TupleLike<T> && std::tuple_size_v<T> == 2U && requires
+{
+    requires std::integral<std::tuple_element_t<0, T>> || std::is_enum_v<std::tuple_element_t<0, T>>;
+    requires std::integral<std::tuple_element_t<1, T>> || std::is_enum_v<std::tuple_element_t<1, T>>;
+    requires sizeof(std::tuple_element_t<0, T>) <= 4U && sizeof(std::tuple_element_t<1, T>) <= 4U;
+};
+
+/// @brief Combine the hash of an element into the hash of a sequence, order-dependently
+constexpr std::uint64_t hashCombine(std::uint64_t seed, std::uint64_t value)
+{
+    return detail::mix64(seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6U) + (seed >> 2U)));
+}
+
+/// @brief Pack two values of at most 32 bits into a 64-bit key, e.g. a grid::Location
+template <class A, class B> constexpr std::uint64_t packPair(A a, B b)
+{
+    const auto high = static_cast<std::uint32_t>(a);
+    const auto low = static_cast<std::uint32_t>(b);
+    return (std::uint64_t { high } << 32U) | low;
+}
+
+/// @brief Hash of tuple-like values (std::pair, std::tuple, std::array...) of any size.
+///        Element hashes are combined with a MurmurHash3-style mixer, so that permutations of the same
+///        elements do not collide; pairs of small integers, such as grid::Location,
+///        are packed into a single 64-bit key first.
+struct TupleHash {
+    template <TupleLike T>
+    auto operator()(const T& t) const noexcept -> std::size_t
+    {
+        if constexpr (PackablePair<T>) {
+            return static_cast<std::size_t>(detail::mix64(packPair(std::get<0>(t), std::get<1>(t))));
+        } else {
+            return [&]<std::size_t... I>(std::index_sequence<I...>) {
+                std::uint64_t seed { std::tuple_size_v<T> };
+                ((seed = hashCombine(seed, hashElement(std::get<I>(t)))), ...);
+                return static_cast<std::size_t>(seed);
+            }(std::make_index_sequence<std::tuple_size_v<T>> {});
+        }
+    }
+
+private:
+    template <class E> static std::uint64_t hashElement(const E& element)
+    {
+        if constexpr (TupleLike<E>)
+            return TupleHash {}(element);
+        else
+            return std::hash<E> {}(element);
+    }
+};
+
+/// @brief TupleHash for tuple-like keys, std::hash otherwise
+template <class Key> using DefaultHash = std::conditional_t<TupleLike<Key>, TupleHash, std::hash<Key>>;
+
+/// @brief Codec storing states as they are
+template <class State> struct IdentityCodec {
+    using key_type = State;
+
+    static const State& encode(const State& state)
+    {
+        return state;
+    }
+
+    static const State& decode(const State& key)
+    {
+        return key;
+    }
+};
+
+/// @brief Dense numbering of the states of a search: each distinct state gets the next uint32 id.
+///
+///        States are stored as keys of a Codec, which may pack them into a single integer
+///        (encode(state) -> key, decode(key) -> state), e.g. a position, a direction and a bitmask of keys
+///        into a std::uint64_t, and are looked up through a FlatMap.
+///
+/// @tparam State state type
+/// @tparam Codec codec with static encode and decode functions and a key_type, which must be
+///         default-constructible and equality-comparable
+/// @tparam Hash hash of the keys
+template <class State, class Codec = IdentityCodec<State>, class Hash = DefaultHash<typename Codec::key_type>>
+class StateStore {
+public:
+    using key_type = typename Codec::key_type;
+
+    std::size_t size() const
+    {
+        return keys_.size();
+    }
+
+    bool empty() const
+    {
+        return keys_.empty();
+    }
+
+    void clear()
+    {
+        ids_.clear();
+        keys_.clear();
+    }
+
+    void reserve(std::size_t count)
+    {
+        ids_.reserve(count);
+        keys_.reserve(count);
+    }
+
+    /// @return the id of @state, and whether it was inserted by this call
+    std::pair<std::uint32_t, bool> insert(const State& state)
+    {
+        const auto before = ids_.size();
+        const key_type key = Codec::encode(state);
+        auto& id = ids_[key];
+        if (ids_.size() == before)
+            return { id, false };
+        id = static_cast<std::uint32_t>(keys_.size());
+        keys_.push_back(key);
+        return { id, true };
+    }
+
+    /// @return the id of @state, nullptr if it was never inserted
+    const std::uint32_t* find(const State& state) const
+    {
+        return ids_.find(Codec::encode(state));
+    }
+
+    bool contains(const State& state) const
+    {
+        return find(state) != nullptr;
+    }
+
+    /// @return the state of id @id
+    State operator[](std::uint32_t id) const
+    {
+        return Codec::decode(keys_[id]);
+    }
+
+private:
+    FlatMap<key_type, std::uint32_t, Hash> ids_ {};
+    std::vector<key_type> keys_ {};
+};
+
+} // namespace collections
+
+namespace pypp {
+
+/// @brief Default case, when all other arguments have been dealt with.
+///        Advances the last iterator.
+template <class Iterator> void advanceIterators(Iterator&& iterator)
+{
+    std::advance(iterator, 1);
+}
+
+/// @brief Advances the first iterator and forwards the rest of the variadic arguments
+template <class Iterator, class... Iterators>
+void advanceIterators(Iterator&& iterator, Iterators&&... iterators)
+{
+    std::advance(iterator, 1);
+    advanceIterators(std::forward<Iterators>(iterators)...);
+}
+
+namespace detail {
+
+    /// @brief Arguments of the eager zip(), which may decay to iterators (e.g. arrays to pointers)
+    template <class T>
+    concept ZipIterator = std::input_iterator<std::decay_t<T>>;
+
+    /// @brief Whether [@Begin, @End) is an iterator pair: an array is never an end,
+    ///        so zip(array, array...) goes to the lazy zip over ranges instead
+    template <class Begin, class End>
+    concept ZipBounds = std::same_as<std::decay_t<Begin>, std::decay_t<End>>
+        && !std::is_array_v<std::remove_reference_t<End>>;
+
+    template <class Result, class Iterator, class... Iterators>
+    Result zipIterators(Result result, Iterator begin, Iterator end, Iterators... iterators)
+    {
+        for (; begin != end; ++begin, (++iterators, ...))
+            result.push_back(std::make_tuple(*begin, *iterators...));
+
+        return result;
+    }
+
+} // namespace detail
+
+/// @brief Return an iterable of tuples, where the i-th tuple contains the i-th element
+///        from each of the argument iterables.
+///        It turns rows into columns, and colums into rows (similar to transposing a matrix)
+/// @note The elements are copied, and @iterators must have at least as many elements as [@begin, @end);
+///       prefer the lazy zip over ranges, which stops at the shortest one
+template <detail::ZipIterator Begin, detail::ZipIterator End, detail::ZipIterator... Iterators>
+    requires detail::ZipBounds<Begin, End>
+auto zip(Begin&& begin, End&& end, Iterators&&... iterators)
+{
+    using Result = std::vector<
+        std::tuple<std::iter_value_t<std::decay_t<Begin>>, std::iter_value_t<std::decay_t<Iterators>>...>>;
+    return detail::zipIterators<Result, std::decay_t<Begin>, std::decay_t<Iterators>...>(
+        Result {}, begin, end, iterators...);
+}
+
+/// @brief Eager zip() of iterators, whose vector is allocated from @resource
+/// @note Elements which are allocator-aware still use their own allocator
+template <detail::ZipIterator Begin, detail::ZipIterator End, detail::ZipIterator... Iterators>
+    requires detail::ZipBounds<Begin, End>
+auto zip(std::pmr::memory_resource& resource, Begin&& begin, End&& end, Iterators&&... iterators)
+{
+    using Result = std::pmr::vector<
+        std::tuple<std::iter_value_t<std::decay_t<Begin>>, std::iter_value_t<std::decay_t<Iterators>>...>>;
+    return detail::zipIterators<Result, std::decay_t<Begin>, std::decay_t<Iterators>...>(
+        Result { &resource }, begin, end, iterators...);
+}
+
+/// @brief Lazy view of tuples of references, where the i-th tuple refers to the i-th element of each view.
+///        Iteration stops at the end of the shortest view, and nothing is copied or allocated.
+template <std::ranges::view... Views>
+    requires(sizeof...(Views) > 0U)
+class ZipView : public std::ranges::view_interface<ZipView<Views...>> {
+    template <bool Const, class View> using Base = std::conditional_t<Const, const View, View>;
+
+    template <bool Const>
+    static constexpr bool all_forward = (std::ranges::forward_range<Base<Const, Views>> && ...);
+
+public:
+    template <bool Const> class iterator {
+    public:
+        using iterator_concept = std::conditional_t<all_forward<Const>, std::forward_iterator_tag,
+            std::input_iterator_tag>;
+        using iterator_category = std::input_iterator_tag;
+        /// tuples of references are their own values: the tuple specialization of
+        /// std::basic_common_reference, which would relate them to tuples of values, is C++23
+        using value_type = std::tuple<std::ranges::range_reference_t<Base<Const, Views>>...>;
+        using difference_type = std::common_type_t<std::ranges::range_difference_t<Base<Const, Views>>...>;
+
+        iterator() = default;
+
+        explicit iterator(std::tuple<std::ranges::iterator_t<Base<Const, Views>>...> current)
+            : current_ { std::move(current) }
+        {
+        }
+
+        value_type operator*() const
+        {
+            return std::apply([](const auto&... it) { return value_type(*it...); }, current_);
+        }
+
+        iterator& operator++()
+        {
+            std::apply([](auto&... it) { (++it, ...); }, current_);
+            return *this;
+        }
+
+        void operator++(int)
+            requires(!all_forward<Const>)
+        {
+            ++*this;
+        }
+
+        iterator operator++(int)
+            requires all_forward<Const>
+        {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        friend bool operator==(const iterator& a, const iterator& b)
+            requires all_forward<Const>
+        {
+            return a.current_ == b.current_;
+        }
+
+        /// @brief Whether any of the views is exhausted
+        template <class Sentinels> bool reached(const Sentinels& ends) const
+        {
+            return [&]<std::size_t... I>(std::index_sequence<I...>) {
+                return ((std::get<I>(current_) == std::get<I>(ends)) || ...);
+            }(std::index_sequence_for<Views...> {});
+        }
+
+    private:
+        std::tuple<std::ranges::iterator_t<Base<Const, Views>>...> current_ {};
+    };
+
+    template <bool Const> class sentinel {
+    public:
+        sentinel() = default;
+
+        explicit sentinel(std::tuple<std::ranges::sentinel_t<Base<Const, Views>>...> ends)
+            : ends_ { std::move(ends) }
+        {
+        }
+
+        friend bool operator==(const iterator<Const>& it, const sentinel& end)
+        {
+            return it.reached(end.ends_);
+        }
+
+    private:
+        std::tuple<std::ranges::sentinel_t<Base<Const, Views>>...> ends_ {};
+    };
+
+    ZipView() = default;
+
+    explicit ZipView(Views... views)
+        : views_ { std::move(views)... }
+    {
+    }
+
+    iterator<false> begin()
+    {
+        return iterator<false>(apply(views_, std::ranges::begin));
+    }
+
+    iterator<true> begin() const
+        requires(std::ranges::range<const Views> && ...)
+    {
+        return iterator<true>(apply(views_, std::ranges::begin));
+    }
+
+    sentinel<false> end()
+    {
+        return sentinel<false>(apply(views_, std::ranges::end));
+    }
+
+    sentinel<true> end() const
+        requires(std::ranges::range<const Views> && ...)
+    {
+        return sentinel<true>(apply(views_, std::ranges::end));
+    }
+
+    /// @brief Length of the shortest view
+    std::size_t size() const
+        requires(std::ranges::sized_range<const Views> && ...)
+    {
+        return std::apply(
+            [](const auto&... view) {
+                return std::min({ static_cast<std::size_t>(std::ranges::size(view))... });
+            },
+            views_);
+    }
+
+private:
+    /// @return tuple of @function(view) for each view
+    template <class Tuple, class Function> static auto apply(Tuple& views, const Function& function)
+    {
+        return std::apply([&](auto&... view) { return std::tuple(function(view)...); }, views);
+    }
+
+    std::tuple<Views...> views_ {};
+};
+
+template <class... Ranges> ZipView(Ranges&&...) -> ZipView<std::views::all_t<Ranges>...>;
+
+/// @brief Lazily zip ranges (containers, string_views, spans over pointers, other views...) into tuples of
+///        references to their i-th elements, up to the end of the shortest range
+template <std::ranges::viewable_range... Ranges>
+    requires(sizeof...(Ranges) > 0U)
+auto zip(Ranges&&... ranges)
+{
+    return ZipView(std::forward<Ranges>(ranges)...);
+}
+
+/// @brief Statistics of a Memoized function, as Python's cache_info()
+struct CacheInfo {
+    std::size_t hits { 0U };
+    std::size_t misses { 0U };
+    /// number of cached results
+    std::size_t size { 0U };
+    /// maximum number of cached results, 0 if unbounded
+    std::size_t capacity { 0U };
+};
+
+template <class Signature, std::size_t Capacity, class Function> class Memoized;
+
+/// @brief Callable caching the results of @Function, as Python's functools.cache and functools.lru_cache.
+///        Arguments are decayed into a std::tuple key, hashed with collections::TupleHash into a FlatMap.
+///        With a Capacity, at most Capacity results are kept, and the least recently used one is evicted.
+///
+/// @tparam Signature Result(Args...), the signature of the cached function
+/// @tparam Capacity maximum number of cached results, 0 for no limit
+/// @tparam Function called as function(self, args...) if possible, where self is the Memoized object
+///         itself, so that recursive calls also go through the cache; called as function(args...) otherwise
+/// @note Decayed arguments and Result must be default-constructible and copyable
+/// @note Not thread-safe
+template <class Result, class... Args, std::size_t Capacity, class Function>
+class Memoized<Result(Args...), Capacity, Function> {
+public:
+    using key_type = std::tuple<std::decay_t<Args>...>;
+    using result_type = Result;
+
+    explicit Memoized(Function function)
+        : function_ { std::move(function) }
+    {
+    }
+
+    Memoized(const Memoized& other) = delete;
+
+    Memoized& operator=(const Memoized& other) = delete;
+
+    /// @brief Take over the function, cached results and statistics of @other, which is left empty
+    Memoized(Memoized&& other) noexcept(std::is_nothrow_move_constructible_v<Function>)
+        : function_ { std::move(other.function_) }
+        , cache_ { std::move(other.cache_) }
+        , nodes_ { std::move(other.nodes_) }
+        , head_ { other.head_ }
+        , hits_ { other.hits_ }
+        , misses_ { other.misses_ }
+    {
+        other.clear();
+    }
+
+    /// @note Only usable if Function is move-assignable, which lambdas are not
+    Memoized& operator=(Memoized&& other) noexcept(std::is_nothrow_move_assignable_v<Function>)
+    {
+        if (this != &other) {
+            function_ = std::move(other.function_);
+            cache_ = std::move(other.cache_);
+            nodes_ = std::move(other.nodes_);
+            head_ = other.head_;
+            hits_ = other.hits_;
+            misses_ = other.misses_;
+            other.clear();
+        }
+        return *this;
+    }
+
+    /// @return the cached result for @args, calling the function on a miss
+    Result operator()(Args... args)
+    {
+        key_type key { args... };
+        if (const auto* found = cache_.find(key)) {
+            ++hits_;
+            if constexpr (bounded)
+                return touch(*found).value;
+            else
+                return *found;
+        }
+
+        ++misses_;
+        // no reference into the cache is held across the call, which may recurse and insert
+        Result result = call(args...);
+        if constexpr (bounded)
+            store(std::move(key), result);
+        else
+            cache_[std::move(key)] = result;
+
+        return result;
+    }
+
+    CacheInfo cacheInfo() const
+    {
+        return { hits_, misses_, cache_.size(), Capacity };
+    }
+
+    /// @brief Drop the cached results and the statistics
+    void clear()
+    {
+        cache_.clear();
+        nodes_.clear();
+        head_ = npos;
+        hits_ = 0U;
+        misses_ = 0U;
+    }
+
+private:
+    static constexpr bool bounded { Capacity > 0U };
+    static constexpr std::uint32_t npos { std::numeric_limits<std::uint32_t>::max() };
+
+    /// @brief Entry of the recency list: a circular, doubly-linked list of indexes, most recent at head_
+    struct Node {
+        key_type key {};
+        Result value {};
+        std::uint32_t prev { npos };
+        std::uint32_t next { npos };
+    };
+
+    using mapped_type = std::conditional_t<bounded, std::uint32_t, Result>;
+
+    Result call(Args&... args)
+    {
+        if constexpr (std::is_invocable_v<Function&, Memoized&, Args&...>)
+            return function_(*this, args...);
+        else
+            return function_(args...);
+    }
+
+    void unlink(std::uint32_t node)
+    {
+        const auto prev = nodes_[node].prev;
+        const auto next = nodes_[node].next;
+        nodes_[prev].next = next;
+        nodes_[next].prev = prev;
+        if (head_ == node)
+            head_ = next == node ? npos : next;
+    }
+
+    void pushFront(std::uint32_t node)
+    {
+        if (head_ == npos) {
+            nodes_[node].prev = node;
+            nodes_[node].next = node;
+        } else {
+            const auto tail = nodes_[head_].prev;
+            nodes_[node].prev = tail;
+            nodes_[node].next = head_;
+            nodes_[tail].next = node;
+            nodes_[head_].prev = node;
+        }
+        head_ = node;
+    }
+
+    Node& touch(std::uint32_t node)
+    {
+        if (node != head_) {
+            unlink(node);
+            pushFront(node);
+        }
+        return nodes_[node];
+    }
+
+    void store(key_type&& key, const Result& result)
+    {
+        std::uint32_t node { 0U };
+        if (nodes_.size() < Capacity) {
+            node = static_cast<std::uint32_t>(nodes_.size());
+            nodes_.emplace_back();
+        } else {
+            node = nodes_[head_].prev;
+            cache_.erase(nodes_[node].key);
+            unlink(node);
+        }
+
+        nodes_[node].key = key;
+        nodes_[node].value = result;
+        cache_[std::move(key)] = node;
+        pushFront(node);
+    }
+
+    Function function_;
+    collections::FlatMap<key_type, mapped_type, collections::TupleHash> cache_ {};
+    /// recency list, only used with a Capacity
+    std::vector<Node> nodes_ {};
+    std::uint32_t head_ { npos };
+    std::size_t hits_ { 0U };
+    std::size_t misses_ { 0U };
+};
+
+/// @brief Cache every result of @function, e.g. a recursive one:
+///        auto fib = memoize<long(int)>(
+///            [](auto& self, int n) -> long { return n < 2 ? n : self(n - 1) + self(n - 2); });
+///
+/// @tparam Signature Result(Args...), the signature of @function without the self parameter
+/// @return a Memoized callable, see Memoized for how @function is called
+template <class Signature, class Function> auto memoize(Function function)
+{
+    return Memoized<Signature, 0U, Function>(std::move(function));
+}
+
+/// @brief Cache the Capacity most recently used results of @function, see memoize()
+template <std::size_t Capacity, class Signature, class Function> auto lruCache(Function function)
+{
+    static_assert(Capacity > 0U, "lruCache: use memoize for an unbounded cache");
+    static_assert(Capacity < std::numeric_limits<std::uint32_t>::max(), "lruCache: capacity too large");
+    return Memoized<Signature, Capacity, Function>(std::move(function));
+}
+
+} // namespace pypp
+
+template <class... Views>
+inline constexpr bool std::ranges::enable_borrowed_range<pypp::ZipView<Views...>>
+    = (std::ranges::enable_borrowed_range<Views> && ...);
+
+/// @brief Lazy, allocation-free equivalents of Python's itertools: product, combinations, permutations,
+///        pairwise, slidingWindow, chunked and accumulate. Like pypp::zip, they yield tuples of references
+///        (or subranges), and compose with zip and std::views.
+///
+///        product, combinations and permutations also know their size and can seek to the i-th element with
+///        iteratorAt(i), so that parallelForEach can split their elements across threads.
+namespace itertools {
+
+namespace detail {
+
+    /// @return @a * @b, or the maximum std::size_t on overflow
+    constexpr std::size_t multiplySaturated(std::size_t a, std::size_t b)
+    {
+        if (a != 0U && b > std::numeric_limits<std::size_t>::max() / a)
+            return std::numeric_limits<std::size_t>::max();
+        return a * b;
+    }
+
+    /// @return n choose k, or the maximum std::size_t on overflow
+    constexpr std::size_t binomial(std::size_t n, std::size_t k)
+    {
+        if (k > n)
+            return 0U;
+        k = std::min(k, n - k);
+        std::size_t result { 1U };
+        for (std::size_t i = 0U; i < k; ++i) {
+            // result * (n - i) / (i + 1) is exact, as the product of i + 1 consecutive integers
+            const auto gcd = std::gcd(result, i + 1U);
+            const auto scaled = multiplySaturated(result / gcd, (n - i) / ((i + 1U) / gcd));
+            if (scaled == std::numeric_limits<std::size_t>::max())
+                return scaled;
+            result = scaled;
+        }
+        return result;
+    }
+
+    /// @return number of ordered selections of k among n, or the maximum std::size_t on overflow
+    constexpr std::size_t arrangements(std::size_t n, std::size_t k)
+    {
+        if (k > n)
+            return 0U;
+        std::size_t result { 1U };
+        for (std::size_t i = 0U; i < k; ++i)
+            result = multiplySaturated(result, n - i);
+        return result;
+    }
+
+    template <class T, std::size_t> using Repeat = T;
+
+    /// @brief Tuple of K references to elements of @range, at @indices
+    template <class Range, std::size_t K, std::size_t... I>
+    auto referencesAt(
+        const Range& range, const std::array<std::size_t, K>& indices, std::index_sequence<I...>)
+    {
+        using Reference = std::ranges::range_reference_t<const Range>;
+        return std::tuple<Repeat<Reference, I>...>(
+            std::ranges::begin(range)[static_cast<std::ptrdiff_t>(indices[I])]...);
+    }
+
+} // namespace detail
+
+/// @brief Cartesian product of forward views, in lexicographic order: the last view varies fastest
+template <std::ranges::view... Views>
+    requires(sizeof...(Views) > 0U && (std::ranges::forward_range<const Views> && ...))
+class ProductView : public std::ranges::view_interface<ProductView<Views...>> {
+public:
+    class iterator {
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::tuple<std::ranges::range_reference_t<const Views>...>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        iterator(const ProductView* parent, std::size_t index)
+            : parent_ { parent }
+            , index_ { index }
+        {
+            auto rest = index;
+            seek(rest, std::index_sequence_for<Views...> {});
+        }
+
+        value_type operator*() const
+        {
+            return std::apply([](const auto&... it) { return value_type(*it...); }, current_);
+        }
+
+        iterator& operator++()
+        {
+            ++index_;
+            increment<sizeof...(Views) - 1U>();
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        friend bool operator==(const iterator& a, const iterator& b)
+        {
+            return a.index_ == b.index_;
+        }
+
+    private:
+        /// @brief Odometer step: advance the I-th iterator, wrapping around and carrying to the previous one
+        template <std::size_t I> void increment()
+        {
+            auto& it = std::get<I>(current_);
+            if (++it != std::ranges::end(std::get<I>(parent_->views_)))
+                return;
+            if constexpr (I > 0U) {
+                it = std::ranges::begin(std::get<I>(parent_->views_));
+                increment<I - 1U>();
+            }
+        }
+
+        /// @brief Position the iterators on the @rest-th element, as mixed-radix digits
+        template <std::size_t... I> void seek(std::size_t rest, std::index_sequence<I...>)
+        {
+            std::array<std::size_t, sizeof...(Views)> digits {};
+            for (std::size_t i = sizeof...(Views); i-- > 0U;) {
+                const auto radix = std::max<std::size_t>(parent_->sizes_[i], 1U);
+                digits[i] = i == 0U ? rest : rest % radix;
+                rest /= radix;
+            }
+            current_ = { std::ranges::next(std::ranges::begin(std::get<I>(parent_->views_)),
+                static_cast<std::ptrdiff_t>(std::min(digits[I], parent_->sizes_[I])))... };
+        }
+
+        const ProductView* parent_ { nullptr };
+        std::tuple<std::ranges::iterator_t<const Views>...> current_ {};
+        std::size_t index_ { 0U };
+    };
+
+    ProductView() = default;
+
+    explicit ProductView(Views... views)
+        : views_ { std::move(views)... }
+    {
+        sizes_ = std::apply(
+            [](const auto&... view) {
+                return std::array<std::size_t, sizeof...(Views)> { static_cast<std::size_t>(
+                    std::ranges::distance(view))... };
+            },
+            views_);
+        size_ = 1U;
+        for (const auto size : sizes_)
+            size_ = detail::multiplySaturated(size_, size);
+    }
+
+    iterator begin() const
+    {
+        return iteratorAt(0U);
+    }
+
+    iterator end() const
+    {
+        return iteratorAt(size_);
+    }
+
+    /// @brief Number of tuples, saturated to the maximum std::size_t
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+    /// @return iterator to the @index-th tuple, end() if @index >= size()
+    iterator iteratorAt(std::size_t index) const
+    {
+        return iterator(this, std::min(index, size_));
+    }
+
+private:
+    std::tuple<Views...> views_ {};
+    std::array<std::size_t, sizeof...(Views)> sizes_ {};
+    std::size_t size_ { 0U };
+};
+
+template <class... Ranges> ProductView(Ranges&&...) -> ProductView<std::views::all_t<Ranges>...>;
+
+/// @brief Lazy cartesian product of forward ranges, yielding tuples of references
+template <std::ranges::viewable_range... Ranges> auto product(Ranges&&... ranges)
+{
+    return ProductView(std::forward<Ranges>(ranges)...);
+}
+
+/// @brief Base of the views over K-tuples of distinct positions of a random-access view,
+///        in lexicographic order of positions
+template <class Derived, std::size_t K, std::ranges::view View>
+    requires std::ranges::random_access_range<const View> && std::ranges::sized_range<const View>
+class IndexTupleView : public std::ranges::view_interface<Derived> {
+public:
+    class iterator {
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = decltype(detail::referencesAt(
+            std::declval<const View&>(), std::declval<const std::array<std::size_t, K>&>(),
+            std::make_index_sequence<K> {}));
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        iterator(const Derived* parent, std::size_t index)
+            : parent_ { parent }
+            , index_ { index }
+        {
+            if (index_ < parent_->size())
+                parent_->unrank(index_, positions_);
+        }
+
+        value_type operator*() const
+        {
+            return detail::referencesAt(parent_->view_, positions_, std::make_index_sequence<K> {});
+        }
+
+        /// @return positions in the underlying view of the current elements
+        const std::array<std::size_t, K>& positions() const
+        {
+            return positions_;
+        }
+
+        iterator& operator++()
+        {
+            if (++index_ < parent_->size())
+                parent_->next(positions_);
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        friend bool operator==(const iterator& a, const iterator& b)
+        {
+            return a.index_ == b.index_;
+        }
+
+    private:
+        const Derived* parent_ { nullptr };
+        std::array<std::size_t, K> positions_ {};
+        std::size_t index_ { 0U };
+    };
+
+    IndexTupleView() = default;
+
+    explicit IndexTupleView(View view)
+        : view_ { std::move(view) }
+        , n_ { static_cast<std::size_t>(std::ranges::size(view_)) }
+        , size_ { Derived::count(n_) }
+    {
+    }
+
+    iterator begin() const
+    {
+        return iteratorAt(0U);
+    }
+
+    iterator end() const
+    {
+        return iteratorAt(size_);
+    }
+
+    /// @brief Number of tuples, saturated to the maximum std::size_t
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+    /// @return iterator to the @index-th tuple, end() if @index >= size()
+    iterator iteratorAt(std::size_t index) const
+    {
+        return iterator(static_cast<const Derived*>(this), std::min(index, size_));
+    }
+
+protected:
+    View view_ {};
+    std::size_t n_ { 0U };
+    std::size_t size_ { 0U };
+};
+
+/// @brief K-combinations of the elements of a random-access view, as Python's itertools.combinations
+template <std::size_t K, std::ranges::view View>
+class CombinationsView : public IndexTupleView<CombinationsView<K, View>, K, View> {
+    using Base = IndexTupleView<CombinationsView<K, View>, K, View>;
+    friend Base;
+
+public:
+    CombinationsView() = default;
+
+    explicit CombinationsView(View view)
+        : Base(std::move(view))
+    {
+    }
+
+private:
+    static std::size_t count(std::size_t n)
+    {
+        return detail::binomial(n, K);
+    }
+
+    void next(std::array<std::size_t, K>& positions) const
+    {
+        auto i = K;
+        while (i-- > 0U && positions[i] == i + this->n_ - K) { }
+        ++positions[i];
+        for (auto j = i + 1U; j < K; ++j)
+            positions[j] = positions[j - 1U] + 1U;
+    }
+
+    /// @brief Combinatorial number system: skip the combinations starting with smaller positions
+    void unrank(std::size_t rank, std::array<std::size_t, K>& positions) const
+    {
+        std::size_t candidate { 0U };
+        for (std::size_t j = 0U; j < K; ++j, ++candidate) {
+            for (;; ++candidate) {
+                const auto skipped = detail::binomial(this->n_ - candidate - 1U, K - j - 1U);
+                if (rank < skipped)
+                    break;
+                rank -= skipped;
+            }
+            positions[j] = candidate;
+        }
+    }
+};
+
+/// @brief Lazy K-combinations of a random-access range, yielding tuples of K references
+template <std::size_t K, std::ranges::viewable_range Range> auto combinations(Range&& range)
+{
+    return CombinationsView<K, std::views::all_t<Range>>(std::views::all(std::forward<Range>(range)));
+}
+
+/// @brief K-permutations of the elements of a random-access view, as Python's itertools.permutations
+template <std::size_t K, std::ranges::view View>
+class PermutationsView : public IndexTupleView<PermutationsView<K, View>, K, View> {
+    using Base = IndexTupleView<PermutationsView<K, View>, K, View>;
+    friend Base;
+
+public:
+    PermutationsView() = default;
+
+    explicit PermutationsView(View view)
+        : Base(std::move(view))
+    {
+    }
+
+private:
+    static std::size_t count(std::size_t n)
+    {
+        return detail::arrangements(n, K);
+    }
+
+    static bool isUsed(const std::array<std::size_t, K>& positions, std::size_t count, std::size_t position)
+    {
+        return std::find(positions.begin(), positions.begin() + count, position) != positions.begin() + count;
+    }
+
+    /// @return the smallest position > @after which is not among the first @count positions, n_ if none
+    std::size_t nextUnused(
+        const std::array<std::size_t, K>& positions, std::size_t count, std::size_t after) const
+    {
+        auto position = after + 1U;
+        while (position < this->n_ && isUsed(positions, count, position))
+            ++position;
+        return position;
+    }
+
+    void next(std::array<std::size_t, K>& positions) const
+    {
+        auto i = K;
+        while (i-- > 0U) {
+            const auto candidate = nextUnused(positions, i, positions[i]);
+            if (candidate < this->n_) {
+                positions[i] = candidate;
+                break;
+            }
+        }
+        for (auto j = i + 1U; j < K; ++j)
+            positions[j] = nextUnused(positions, j, std::numeric_limits<std::size_t>::max());
+    }
+
+    /// @brief Factorial number system: the j-th position is the d-th unused one, with d the j-th digit
+    void unrank(std::size_t rank, std::array<std::size_t, K>& positions) const
+    {
+        for (std::size_t j = 0U; j < K; ++j) {
+            const auto block = detail::arrangements(this->n_ - j - 1U, K - j - 1U);
+            auto digit = rank / block;
+            rank %= block;
+            auto position = nextUnused(positions, j, std::numeric_limits<std::size_t>::max());
+            for (; digit > 0U; --digit)
+                position = nextUnused(positions, j, position);
+            positions[j] = position;
+        }
+    }
+};
+
+/// @brief Lazy K-permutations of a random-access range, yielding tuples of K references
+template <std::size_t K, std::ranges::viewable_range Range> auto permutations(Range&& range)
+{
+    return PermutationsView<K, std::views::all_t<Range>>(std::views::all(std::forward<Range>(range)));
+}
+
+/// @brief Overlapping windows of n consecutive elements of a forward view, as subranges
+template <std::ranges::view View>
+    requires std::ranges::forward_range<const View>
+class SlidingWindowView : public std::ranges::view_interface<SlidingWindowView<View>> {
+    using Base = std::ranges::iterator_t<const View>;
+
+public:
+    class iterator {
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::ranges::subrange<Base>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        iterator(Base first, Base last)
+            : first_ { std::move(first) }
+            , last_ { std::move(last) }
+        {
+        }
+
+        value_type operator*() const
+        {
+            return { first_, std::ranges::next(last_) };
+        }
+
+        iterator& operator++()
+        {
+            ++first_;
+            ++last_;
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        friend bool operator==(const iterator& a, const iterator& b)
+        {
+            return a.first_ == b.first_;
+        }
+
+        /// @brief The last element of the window is past the end of the view
+        friend bool operator==(const iterator& it, const std::ranges::sentinel_t<const View>& end)
+        {
+            return it.last_ == end;
+        }
+
+    private:
+        Base first_ {};
+        /// last element of the window
+        Base last_ {};
+    };
+
+    SlidingWindowView() = default;
+
+    /// @throw std::invalid_argument if @n is 0
+    SlidingWindowView(View view, std::size_t n)
+        : view_ { std::move(view) }
+        , n_ { n }
+    {
+        if (n_ == 0U)
+            throw std::invalid_argument("slidingWindow: window size must be positive");
+    }
+
+    iterator begin() const
+    {
+        const auto first = std::ranges::begin(view_);
+        return iterator(first,
+            std::ranges::next(first, static_cast<std::ptrdiff_t>(n_ - 1U), std::ranges::end(view_)));
+    }
+
+    std::ranges::sentinel_t<const View> end() const
+    {
+        return std::ranges::end(view_);
+    }
+
+    std::size_t size() const
+        requires std::ranges::sized_range<const View>
+    {
+        const auto size = static_cast<std::size_t>(std::ranges::size(view_));
+        return size < n_ ? 0U : size - n_ + 1U;
+    }
+
+private:
+    View view_ {};
+    std::size_t n_ { 1U };
+};
+
+/// @brief Lazy overlapping windows of @n consecutive elements of a forward range, as subranges
+template <std::ranges::viewable_range Range> auto slidingWindow(Range&& range, std::size_t n)
+{
+    return SlidingWindowView<std::views::all_t<Range>>(std::views::all(std::forward<Range>(range)), n);
+}
+
+/// @brief Lazy pairs of consecutive elements of a forward range, yielding tuples of two references
+template <std::ranges::viewable_range Range> auto pairwise(Range&& range)
+{
+    return slidingWindow(std::forward<Range>(range), 2U) | std::views::transform([](const auto& window) {
+        const auto first = window.begin();
+        return std::tuple<decltype(*first), decltype(*first)>(*first, *std::ranges::next(first));
+    });
+}
+
+/// @brief Consecutive chunks of n elements of a forward view, the last one possibly shorter, as subranges
+template <std::ranges::view View>
+    requires std::ranges::forward_range<const View>
+class ChunkedView : public std::ranges::view_interface<ChunkedView<View>> {
+    using Base = std::ranges::iterator_t<const View>;
+    using End = std::ranges::sentinel_t<const View>;
+
+public:
+    class iterator {
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::ranges::subrange<Base>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        iterator(Base first, End end, std::size_t n)
+            : first_ { std::move(first) }
+            , end_ { std::move(end) }
+            , n_ { n }
+        {
+        }
+
+        value_type operator*() const
+        {
+            return { first_, std::ranges::next(first_, static_cast<std::ptrdiff_t>(n_), end_) };
+        }
+
+        iterator& operator++()
+        {
+            std::ranges::advance(first_, static_cast<std::ptrdiff_t>(n_), end_);
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        friend bool operator==(const iterator& a, const iterator& b)
+        {
+            return a.first_ == b.first_;
+        }
+
+        friend bool operator==(const iterator& it, const End& end)
+        {
+            return it.first_ == end;
+        }
+
+    private:
+        Base first_ {};
+        End end_ {};
+        std::size_t n_ { 1U };
+    };
+
+    ChunkedView() = default;
+
+    /// @throw std::invalid_argument if @n is 0
+    ChunkedView(View view, std::size_t n)
+        : view_ { std::move(view) }
+        , n_ { n }
+    {
+        if (n_ == 0U)
+            throw std::invalid_argument("chunked: chunk size must be positive");
+    }
+
+    iterator begin() const
+    {
+        return iterator(std::ranges::begin(view_), std::ranges::end(view_), n_);
+    }
+
+    End end() const
+    {
+        return std::ranges::end(view_);
+    }
+
+    std::size_t size() const
+        requires std::ranges::sized_range<const View>
+    {
+        return (static_cast<std::size_t>(std::ranges::size(view_)) + n_ - 1U) / n_;
+    }
+
+private:
+    View view_ {};
+    std::size_t n_ { 1U };
+};
+
+/// @brief Lazy chunks of @n consecutive elements of a forward range, as subranges
+template <std::ranges::viewable_range Range> auto chunked(Range&& range, std::size_t n)
+{
+    return ChunkedView<std::views::all_t<Range>>(std::views::all(std::forward<Range>(range)), n);
+}
+
+/// @brief Running results of a binary operation over a view, as Python's itertools.accumulate
+template <std::ranges::view View, class Operation>
+    requires std::ranges::input_range<const View>
+class AccumulateView : public std::ranges::view_interface<AccumulateView<View, Operation>> {
+    using Base = std::ranges::iterator_t<const View>;
+    using End = std::ranges::sentinel_t<const View>;
+
+public:
+    using total_type = std::decay_t<std::invoke_result_t<const Operation&,
+        std::ranges::range_value_t<const View>, std::ranges::range_reference_t<const View>>>;
+
+    class iterator {
+    public:
+        using iterator_concept
+            = std::conditional_t<std::ranges::forward_range<const View>, std::forward_iterator_tag,
+                std::input_iterator_tag>;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = total_type;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        explicit iterator(const AccumulateView* parent)
+            : parent_ { parent }
+            , current_ { std::ranges::begin(parent->view_) }
+        {
+            if (current_ != std::ranges::end(parent_->view_))
+                total_ = *current_;
+        }
+
+        const value_type& operator*() const
+        {
+            return total_;
+        }
+
+        iterator& operator++()
+        {
+            if (++current_ != std::ranges::end(parent_->view_))
+                total_ = std::invoke(parent_->operation_, std::move(total_), *current_);
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        friend bool operator==(const iterator& a, const iterator& b)
+            requires std::ranges::forward_range<const View>
+        {
+            return a.current_ == b.current_;
+        }
+
+        friend bool operator==(const iterator& it, const End& end)
+        {
+            return it.current_ == end;
+        }
+
+    private:
+        const AccumulateView* parent_ { nullptr };
+        Base current_ {};
+        value_type total_ {};
+    };
+
+    AccumulateView() = default;
+
+    AccumulateView(View view, Operation operation)
+        : view_ { std::move(view) }
+        , operation_ { std::move(operation) }
+    {
+    }
+
+    iterator begin() const
+    {
+        return iterator(this);
+    }
+
+    End end() const
+    {
+        return std::ranges::end(view_);
+    }
+
+    std::size_t size() const
+        requires std::ranges::sized_range<const View>
+    {
+        return static_cast<std::size_t>(std::ranges::size(view_));
+    }
+
+private:
+    View view_ {};
+    Operation operation_ {};
+};
+
+/// @brief Lazy running totals of a range, or running results of @operation, e.g. std::ranges::max
+template <std::ranges::viewable_range Range, class Operation = std::plus<>>
+auto accumulate(Range&& range, Operation operation = {})
+{
+    return AccumulateView<std::views::all_t<Range>, Operation>(
+        std::views::all(std::forward<Range>(range)), std::move(operation));
+}
+
+/// @brief Views whose elements can be reached by index, to be split across threads
+template <class View>
+concept Partitionable = requires(const View& view, std::size_t index) {
+    {
+        view.size()
+    } -> std::convertible_to<std::size_t>;
+    view.iteratorAt(index);
+};
+
+/// @return the elements of @view in the @part-th of @parts contiguous slices of the same size (+- 1)
+template <Partitionable View> auto partition(const View& view, std::size_t part, std::size_t parts)
+{
+    const auto size = view.size();
+    const auto sliceStart = [&](std::size_t i) { return i * (size / parts) + std::min(i, size % parts); };
+    return std::ranges::subrange(view.iteratorAt(sliceStart(part)), view.iteratorAt(sliceStart(part + 1U)));
+}
+
+/// @brief Call @function on every element of @view, from a pool of worker threads, each of them iterating
+///        over contiguous slices of the elements
+///
+/// @param threads number of worker threads, 0 for std::thread::hardware_concurrency()
+/// @note @function is called concurrently; the first exception it throws is rethrown
+template <Partitionable View, class Function>
+void parallelForEach(const View& view, Function&& function, unsigned threads = 0U)
+{
+    if (threads == 0U)
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    const auto parts = std::max<std::size_t>(std::min<std::size_t>(view.size(), threads * 8U), 1U);
+    pypp::detail::parallelFor(parts, threads, [&](std::size_t part) {
+        for (auto&& element : partition(view, part, parts))
+            function(element);
+    });
+}
+
+} // namespace itertools
+
+namespace grid {
+
+using Location = std::pair<int, int>;
+
+enum class Direction {
+    UP = 0,
+    DOWN,
+    LEFT,
+    RIGHT,
+};
+
+/// @return an iterable of possible {dx, dy} when moving within a 2d grid
+std::array<Location, 4U> move()
+{
+    return { std::make_pair(-1, 0), std::make_pair(1, 0), std::make_pair(0, 1), std::make_pair(0, -1) };
+}
+
+/// @return an iterable of possible {{dx, dy}, DIR} when moving within a 2d grid
+std::array<std::pair<Location, Direction>, 4U> moveWithDIR()
+{
+    return { std::make_pair(std::make_pair(-1, 0), Direction::UP),
+        std::make_pair(std::make_pair(1, 0), Direction::DOWN),
+        std::make_pair(std::make_pair(0, 1), Direction::LEFT),
+        std::make_pair(std::make_pair(0, -1), Direction::RIGHT) };
+}
+
+bool inBounds(const strings& grid, int x, int y)
+{
+    const auto n = grid.size();
+    const auto m = grid[0].length();
+
+    return 0 <= x && x < n && 0 <= y && y < m;
+}
+
+/// @brief 2d grid stored in a single row-major buffer, addressed either by {x, y} (row, column) locations
+///        or by linear indices, with index(x, y) = x * stride() + y.
+///
+///        An optional sentinel border of one cell surrounds the grid: neighbors of any in-bounds cell can
+///        then be read without bounds checks, by adding neighborOffsets() to its linear index.
+///        A Grid<const char> can also view a memory-mapped file in place, newlines being skipped by the
+///        stride.
+///
+/// @tparam T cell type (use char or std::uint8_t rather than bool)
+template <class T> class Grid {
+    static_assert(!std::is_same_v<std::remove_cv_t<T>, bool>, "std::vector<bool> cannot back a Grid");
+
+public:
+    using value_type = std::remove_const_t<T>;
+
+    Grid() = default;
+
+    /// @param rows number of rows
+    /// @param cols number of columns
+    /// @param fill initial value of the cells
+    /// @param border value of the sentinel border, if any
+    Grid(int rows, int cols, const value_type& fill = {}, std::optional<value_type> border = std::nullopt)
+        : rows_ { rows }
+        , cols_ { cols }
+        , stride_ { border ? cols + 2 : cols }
+        , border_ { border.has_value() }
+    {
+        const auto padding = border_ ? 2 : 0;
+        buffer_.assign(static_cast<std::size_t>(rows + padding) * static_cast<std::size_t>(stride_),
+            border ? *border : fill);
+        data_ = buffer_.data() + (border_ ? stride_ + 1 : 0);
+        if (border_)
+            for (int x = 0; x < rows_; ++x)
+                std::fill_n(data_ + index(x, 0), cols_, fill);
+    }
+
+    /// @brief Copy lines of equal length, e.g. the output of splitFileLines
+    ///
+    /// @throw std::invalid_argument if the lines do not have the same length
+    explicit Grid(const strings& lines, std::optional<value_type> border = std::nullopt)
+        : Grid(static_cast<int>(lines.size()), lines.empty() ? 0 : static_cast<int>(lines[0].size()),
+            value_type {}, border)
+    {
+        for (int x = 0; x < rows_; ++x) {
+            const auto& line = lines[static_cast<std::size_t>(x)];
+            if (line.size() != static_cast<std::size_t>(cols_))
+                throw std::invalid_argument("Grid: line " + std::to_string(x) + " has length "
+                    + std::to_string(line.size()) + ", expected " + std::to_string(cols_));
+            std::copy(line.begin(), line.end(), data_ + index(x, 0));
+        }
+    }
+
+    /// @brief View the lines of a file in place, without copying them.
+    ///        Lines may end with "\n" or "\r\n"; trailing blank lines are ignored.
+    ///
+    /// @param file an open file, whose ownership is taken by the grid
+    /// @param ec set to the error of the file, or to std::errc::invalid_argument if its lines do not have
+    ///        the same length; the grid is empty then
+    Grid(pypp::MappedFile file, std::error_code& ec)
+        requires std::is_same_v<T, const char>
+    {
+        ec = file.error();
+        if (ec)
+            return;
+
+        auto text = file.view();
+        while (!text.empty() && (text.back() == '\n' || text.back() == '\r'))
+            text.remove_suffix(1U);
+        if (text.empty())
+            return;
+
+        auto cols = text.find('\n');
+        if (cols == std::string_view::npos)
+            cols = text.size();
+        const std::size_t eol = cols > 0U && cols < text.size() && text[cols - 1U] == '\r' ? 2U : 1U;
+        if (eol == 2U)
+            --cols;
+
+        const auto stride = cols + eol;
+        const auto rows = (text.size() + eol) / stride;
+        bool rectangular = (text.size() + eol) % stride == 0U
+            && static_cast<std::size_t>(std::count(text.begin(), text.end(), '\n')) == rows - 1U;
+        for (std::size_t row = 1U; rectangular && row < rows; ++row)
+            rectangular = text[row * stride - 1U] == '\n';
+        if (!rectangular) {
+            ec = std::make_error_code(std::errc::invalid_argument);
+            return;
+        }
+
+        file_ = std::make_shared<const pypp::MappedFile>(std::move(file));
+        data_ = file_->view().data();
+        rows_ = static_cast<int>(rows);
+        cols_ = static_cast<int>(cols);
+        stride_ = static_cast<int>(stride);
+    }
+
+    Grid(const Grid& other)
+        : buffer_ { other.buffer_ }
+        , file_ { other.file_ }
+        , data_ { other.rebase(buffer_) }
+        , rows_ { other.rows_ }
+        , cols_ { other.cols_ }
+        , stride_ { other.stride_ }
+        , border_ { other.border_ }
+    {
+    }
+
+    Grid& operator=(const Grid& other)
+    {
+        if (this != &other)
+            *this = Grid(other);
+        return *this;
+    }
+
+    Grid(Grid&& other) noexcept = default;
+
+    Grid& operator=(Grid&& other) noexcept = default;
+
+    int rows() const
+    {
+        return rows_;
+    }
+
+    int cols() const
+    {
+        return cols_;
+    }
+
+    /// @brief Distance between the linear indices of two vertically adjacent cells
+    int stride() const
+    {
+        return stride_;
+    }
+
+    /// @return number of cells, border excluded
+    std::size_t size() const
+    {
+        return static_cast<std::size_t>(rows_) * static_cast<std::size_t>(cols_);
+    }
+
+    bool empty() const
+    {
+        return size() == 0U;
+    }
+
+    /// @brief Whether a sentinel border surrounds the grid
+    bool hasBorder() const
+    {
+        return border_;
+    }
+
+    /// @return pointer to the cell {0, 0}
+    T* data()
+    {
+        return data_;
+    }
+
+    const T* data() const
+    {
+        return data_;
+    }
+
+    std::ptrdiff_t index(int x, int y) const
+    {
+        return static_cast<std::ptrdiff_t>(x) * stride_ + y;
+    }
+
+    std::ptrdiff_t index(const Location& location) const
+    {
+        return index(location.first, location.second);
+    }
+
+    /// @return location of the in-bounds cell at @index
+    Location location(std::ptrdiff_t index) const
+    {
+        return { static_cast<int>(index / stride_), static_cast<int>(index % stride_) };
+    }
+
+    /// @return linear offsets to the neighbors of a cell, in the order of move()
+    std::array<std::ptrdiff_t, 4U> neighborOffsets() const
+    {
+        return { -stride_, stride_, 1, -1 };
+    }
+
+    bool inBounds(int x, int y) const
+    {
+        return static_cast<unsigned>(x) < static_cast<unsigned>(rows_)
+            && static_cast<unsigned>(y) < static_cast<unsigned>(cols_);
+    }
+
+    bool inBounds(const Location& location) const
+    {
+        return inBounds(location.first, location.second);
+    }
+
+    T& operator()(int x, int y)
+    {
+        return data_[index(x, y)];
+    }
+
+    const T& operator()(int x, int y) const
+    {
+        return data_[index(x, y)];
+    }
+
+    T& operator[](const Location& location)
+    {
+        return data_[index(location)];
+    }
+
+    const T& operator[](const Location& location) const
+    {
+        return data_[index(location)];
+    }
+
+    T& operator[](std::ptrdiff_t index)
+    {
+        return data_[index];
+    }
+
+    const T& operator[](std::ptrdiff_t index) const
+    {
+        return data_[index];
+    }
+
+    /// @return the cells of row @x, border excluded
+    std::span<T> row(int x)
+    {
+        return { data_ + index(x, 0), static_cast<std::size_t>(cols_) };
+    }
+
+    std::span<const T> row(int x) const
+    {
+        return { data_ + index(x, 0), static_cast<std::size_t>(cols_) };
+    }
+
+private:
+    T* rebase(std::vector<value_type>& buffer) const
+    {
+        return buffer_.empty() ? data_ : buffer.data() + (data_ - buffer_.data());
+    }
+
+    std::vector<value_type> buffer_ {};
+    std::shared_ptr<const pypp::MappedFile> file_ {};
+    T* data_ { nullptr };
+    int rows_ { 0 };
+    int cols_ { 0 };
+    int stride_ { 0 };
+    bool border_ { false };
+};
+
+/// @brief Map a file into a Grid<const char>, see Grid(MappedFile, std::error_code&)
+Grid<const char> loadGrid(const std::string& path, std::error_code& ec)
+{
+    return Grid<const char>(pypp::MappedFile(path), ec);
+}
+
+template <class T> bool inBounds(const Grid<T>& grid, int x, int y)
+{
+    return grid.inBounds(x, y);
+}
+
+} // namespace grid
+
+namespace algorithms {
+
+/// @brief Dept-First-Search iterative implementation using std::stack.
+///        Locations are marked as visited when pushed, so that each one is pushed at most once;
+///        see GridSearch for a faster engine over grid::Grid.
+///
+/// @tparam condition predicate to satisfy when exploring locations
+/// @param grid a 2d grid
+/// @param start start grid location
+/// @param visited a set of already visited locations on the grid
+/// @return a vector of reached locations which satisfy @condition
+template <typename Predicate>
+std::vector<grid::Location> dfs(const strings& grid, const grid::Location& start, Predicate condition,
+    std::unordered_set<grid::Location, collections::TupleHash>& visited)
+{
+    std::vector<grid::Location> locations {};
+    if (visited.find(start) != visited.end() || !condition(grid[start.first][start.second]))
+        return locations;
+
+    std::stack<grid::Location, std::vector<grid::Location>> stack {};
+    stack.push(start);
+    visited.insert(start);
+
+    while (!stack.empty()) {
+        auto [cx, cy] = stack.top();
+        stack.pop();
+        locations.push_back({ cx, cy });
+
+        for (auto [dx, dy] : grid::move()) {
+            auto nx = cx + dx;
+            auto ny = cy + dy;
+            if (grid::inBounds(grid, nx, ny) && condition(grid[nx][ny]) && visited.insert({ nx, ny }).second)
+                stack.push({ nx, ny });
+        }
+    }
+
+    return locations;
+}
+
+enum class SearchMode {
+    DFS = 0,
+    BFS,
+};
+
+/// @brief Flood-fill engine over a grid::Grid, reusable across searches without allocating.
+///
+///        Visited cells are tracked in a dense bitset indexed like the cells of the grid, and the frontier is
+///        a vector preallocated to the size of the grid. A cell is marked as visited when pushed, so it
+///        enters the frontier at most once; as with dfs, only cells satisfying the predicate are marked,
+///        and the visited state persists across searches until reset().
+///
+/// @tparam T cell type of the grid
+template <class T> class GridSearch {
+public:
+    /// @param grid grid to search, which must outlive the engine
+    explicit GridSearch(const grid::Grid<T>& grid)
+        : grid_ { &grid }
+        , origin_ { grid.hasBorder() ? grid.stride() + 1 : 0 }
+        , cells_ { static_cast<std::size_t>(grid.rows() + (grid.hasBorder() ? 2 : 0))
+              * static_cast<std::size_t>(grid.stride()) }
+        , visited_((cells_ + 63U) / 64U, 0U)
+    {
+        frontier_.reserve(grid.size());
+        reset();
+    }
+
+    /// @brief Forget all visited cells and distances
+    void reset()
+    {
+        std::fill(visited_.begin(), visited_.end(), 0U);
+        std::fill(distances_.begin(), distances_.end(), -1);
+        if (!grid_->hasBorder())
+            return;
+
+        // the border is never entered, so that neighbors need no bounds check
+        const auto stride = static_cast<std::size_t>(grid_->stride());
+        for (std::size_t bit = 0U; bit < stride; ++bit) {
+            mark(bit);
+            mark(cells_ - 1U - bit);
+        }
+        for (std::size_t row = 1U; row + 1U < cells_ / stride; ++row) {
+            mark(row * stride);
+            mark(row * stride + stride - 1U);
+        }
+    }
+
+    /// @brief Visit every cell reachable from @start through cells satisfying @condition
+    ///
+    /// @param start start grid location
+    /// @param condition predicate on the value of a cell to satisfy when exploring locations
+    /// @param mode DFS explores the last pushed cell first, BFS the closest one
+    /// @param visit callback taking the location of each reached cell and its distance from @start,
+    ///        which is only meaningful in BFS mode (-1 in DFS mode)
+    /// @return the number of reached cells, 0 if @start is out of bounds, already visited
+    ///         or does not satisfy @condition
+    template <typename Predicate, typename Visitor>
+    std::size_t search(const grid::Location& start, Predicate condition, SearchMode mode, Visitor&& visit)
+    {
+        if (grid_->hasBorder())
+            return run<true>(start, condition, mode, visit);
+        return run<false>(start, condition, mode, visit);
+    }
+
+    /// @brief Dept-First-Search from @start, see search()
+    /// @return a vector of reached locations which satisfy @condition
+    template <typename Predicate>
+    std::vector<grid::Location> dfs(const grid::Location& start, Predicate condition)
+    {
+        std::vector<grid::Location> locations {};
+        search(start, condition, SearchMode::DFS,
+            [&](const grid::Location& location, int) { locations.push_back(location); });
+        return locations;
+    }
+
+    /// @brief Breadth-First-Search from @start, see search(); distances are then available through distance()
+    /// @return a vector of reached locations which satisfy @condition, by increasing distance from @start
+    template <typename Predicate>
+    std::vector<grid::Location> bfs(const grid::Location& start, Predicate condition)
+    {
+        std::vector<grid::Location> locations {};
+        search(start, condition, SearchMode::BFS,
+            [&](const grid::Location& location, int) { locations.push_back(location); });
+        return locations;
+    }
+
+    bool isVisited(const grid::Location& location) const
+    {
+        return test(bit(grid_->index(location)));
+    }
+
+    /// @return number of steps from the start of the BFS which reached @location, or -1 if it was not reached
+    int distance(const grid::Location& location) const
+    {
+        return distances_.empty() ? -1 : distances_[bit(grid_->index(location))];
+    }
+
+private:
+    template <bool Bordered, typename Predicate, typename Visitor>
+    std::size_t run(const grid::Location& start, Predicate& condition, SearchMode mode, Visitor& visit)
+    {
+        const auto& grid = *grid_;
+        if (!grid.inBounds(start))
+            return 0U;
+        const auto start_index = grid.index(start);
+        if (test(bit(start_index)) || !condition(grid[start_index]))
+            return 0U;
+
+        const bool bfs = mode == SearchMode::BFS;
+        if (bfs && distances_.empty())
+            distances_.assign(cells_, -1);
+
+        const auto offsets = grid.neighborOffsets();
+        const auto steps = grid::move();
+        frontier_.clear();
+        frontier_.push_back(start);
+        mark(bit(start_index));
+        if (bfs)
+            distances_[bit(start_index)] = 0;
+
+        std::size_t reached { 0U };
+        std::size_t head { 0U };
+        while (head < frontier_.size()) {
+            grid::Location current {};
+            if (bfs) {
+                current = frontier_[head++];
+            } else {
+                current = frontier_.back();
+                frontier_.pop_back();
+            }
+            const auto index = grid.index(current);
+            const auto distance = bfs ? distances_[bit(index)] : -1;
+            visit(current, distance);
+            ++reached;
+
+            for (std::size_t direction = 0U; direction < offsets.size(); ++direction) {
+                const grid::Location next { current.first + steps[direction].first,
+                    current.second + steps[direction].second };
+                if constexpr (!Bordered) {
+                    if (!grid.inBounds(next))
+                        continue;
+                }
+                const auto next_index = index + offsets[direction];
+                const auto next_bit = bit(next_index);
+                if (test(next_bit) || !condition(grid[next_index]))
+                    continue;
+                mark(next_bit);
+                if (bfs)
+                    distances_[next_bit] = distance + 1;
+                frontier_.push_back(next);
+            }
+        }
+
+        return reached;
+    }
+
+    std::size_t bit(std::ptrdiff_t index) const
+    {
+        return static_cast<std::size_t>(index + origin_);
+    }
+
+    bool test(std::size_t bit) const
+    {
+        return (visited_[bit / 64U] >> (bit % 64U)) & 1U;
+    }
+
+    void mark(std::size_t bit)
+    {
+        visited_[bit / 64U] |= std::uint64_t { 1U } << (bit % 64U);
+    }
+
+    const grid::Grid<T>* grid_;
+    std::ptrdiff_t origin_;
+    std::size_t cells_;
+    std::vector<std::uint64_t> visited_;
+    std::vector<int> distances_ {};
+    std::vector<grid::Location> frontier_ {};
+};
+
+/// @brief Result of labelComponents
+struct ComponentLabels {
+    /// label of each cell, -1 for cells which do not satisfy the predicate
+    grid::Grid<int> labels {};
+    /// number of cells of each component, indexed by label
+    std::vector<std::size_t> sizes {};
+};
+
+namespace detail {
+
+    /// @brief Root of @cell in a union-find forest, halving the path on the way
+    std::uint32_t findRoot(std::vector<std::uint32_t>& parent, std::uint32_t cell)
+    {
+        while (parent[cell] != cell) {
+            parent[cell] = parent[parent[cell]];
+            cell = parent[cell];
+        }
+        return cell;
+    }
+
+    /// @brief Merge the trees of @a and @b, the smallest root becoming the root of both
+    void unite(std::vector<std::uint32_t>& parent, std::uint32_t a, std::uint32_t b)
+    {
+        a = findRoot(parent, a);
+        b = findRoot(parent, b);
+        if (a < b)
+            parent[b] = a;
+        else if (b < a)
+            parent[a] = b;
+    }
+
+} // namespace detail
+
+/// @brief Label the 4-connected components of the cells satisfying @condition.
+///
+///        The grid is cut into row stripes, which are labeled in parallel with a union-find forest whose
+///        roots are the smallest cell index of their tree; trees are then merged across stripe boundaries,
+///        and labels are assigned to roots. Components are numbered by their first cell in row-major order,
+///        i.e. in the order calling dfs on every location, row by row, would find them.
+///
+/// @tparam condition predicate on the value of a cell to satisfy to belong to a component
+/// @param grid a 2d grid
+/// @param threads number of worker threads, 0 for std::thread::hardware_concurrency()
+/// @return a label per cell and the size of each component
+template <class T, typename Predicate>
+ComponentLabels labelComponents(const grid::Grid<T>& grid, Predicate condition, unsigned threads = 0U)
+{
+    constexpr auto background = std::numeric_limits<std::uint32_t>::max();
+    const auto rows = static_cast<std::size_t>(grid.rows());
+    const auto cols = static_cast<std::size_t>(grid.cols());
+
+    ComponentLabels result { grid::Grid<int>(grid.rows(), grid.cols(), -1), {} };
+    if (grid.empty())
+        return result;
+
+    if (threads == 0U)
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    const auto stripe_rows = std::max<std::size_t>((rows + threads - 1U) / threads, 16U);
+    const auto stripes = (rows + stripe_rows - 1U) / stripe_rows;
+    const auto stripeBegin = [&](std::size_t stripe) { return std::min(stripe * stripe_rows, rows) * cols; };
+
+    // first pass: a forest per stripe, linking each cell to its left and upper neighbors
+    std::vector<std::uint32_t> parent(rows * cols, background);
+    pypp::detail::parallelFor(stripes, threads, [&](std::size_t stripe) {
+        const auto first_row = stripe * stripe_rows;
+        const auto last_row = std::min(first_row + stripe_rows, rows);
+        for (auto x = first_row; x < last_row; ++x) {
+            for (std::size_t y = 0U; y < cols; ++y) {
+                if (!condition(grid(static_cast<int>(x), static_cast<int>(y))))
+                    continue;
+                const auto cell = static_cast<std::uint32_t>(x * cols + y);
+                const auto up = static_cast<std::uint32_t>(cell - cols);
+                const bool has_left = y > 0U && parent[cell - 1U] != background;
+                const bool has_up = x > first_row && parent[up] != background;
+                parent[cell] = has_left ? parent[cell - 1U] : (has_up ? parent[up] : cell);
+                // left and up are already connected through the upper-left cell
+                if (has_left && has_up && parent[up - 1U] == background)
+                    detail::unite(parent, up, cell);
+            }
+        }
+    });
+
+    // stitch the forests across stripe boundaries
+    for (std::size_t stripe = 1U; stripe < stripes; ++stripe) {
+        const auto begin = stripeBegin(stripe);
+        for (auto cell = begin; cell < begin + cols; ++cell)
+            if (parent[cell] != background && parent[cell - cols] != background)
+                detail::unite(
+                    parent, static_cast<std::uint32_t>(cell - cols), static_cast<std::uint32_t>(cell));
+    }
+
+    // number the roots: count them per stripe, then label them from the prefix sum of the counts
+    std::vector<std::size_t> first_label(stripes + 1U, 0U);
+    pypp::detail::parallelFor(stripes, threads, [&](std::size_t stripe) {
+        std::size_t roots { 0U };
+        for (auto cell = stripeBegin(stripe); cell < stripeBegin(stripe + 1U); ++cell)
+            roots += parent[cell] == cell;
+        first_label[stripe + 1U] = roots;
+    });
+    std::partial_sum(first_label.begin(), first_label.end(), first_label.begin());
+
+    auto* labels = result.labels.data();
+    pypp::detail::parallelFor(stripes, threads, [&](std::size_t stripe) {
+        auto label = static_cast<int>(first_label[stripe]);
+        for (auto cell = stripeBegin(stripe); cell < stripeBegin(stripe + 1U); ++cell)
+            if (parent[cell] == cell)
+                labels[cell] = label++;
+    });
+
+    // label the other cells after their root, which precedes them; the forest is now read-only
+    result.sizes.assign(first_label.back(), 0U);
+    std::vector<std::unordered_map<int, std::size_t>> foreign_sizes(stripes);
+    pypp::detail::parallelFor(stripes, threads, [&](std::size_t stripe) {
+        const auto own_begin = static_cast<int>(first_label[stripe]);
+        const auto own_end = static_cast<int>(first_label[stripe + 1U]);
+        for (auto cell = stripeBegin(stripe); cell < stripeBegin(stripe + 1U); ++cell) {
+            if (parent[cell] == background)
+                continue;
+            auto root = parent[cell];
+            while (parent[root] != root)
+                root = parent[root];
+            const auto label = labels[root];
+            if (root != cell)
+                labels[cell] = label;
+            if (own_begin <= label && label < own_end)
+                ++result.sizes[static_cast<std::size_t>(label)];
+            else
+                ++foreign_sizes[stripe][label];
+        }
+    });
+    for (const auto& sizes : foreign_sizes)
+        for (const auto& [label, size] : sizes)
+            result.sizes[static_cast<std::size_t>(label)] += size;
+
+    return result;
+}
+
+/// @brief State of a shortest-path search over a grid: a location and, for turn-cost problems,
+///        the direction of the move which reached it
+struct GridState {
+    grid::Location location {};
+    grid::Direction direction { grid::Direction::UP };
+
+    bool operator==(const GridState& other) const = default;
+};
+
+/// @brief Default A* heuristic, which turns GridPaths into Dijkstra's algorithm
+struct NoHeuristic {
+    int operator()(const GridState&) const
+    {
+        return 0;
+    }
+};
+
+/// @brief Dijkstra / A* engine over a grid::Grid with small non-negative integer move costs.
+///
+///        States are a location, plus the direction it was entered from when directional, i.e. 4 states per
+///        cell. Distances, predecessors and settled states are stored in flat arrays indexed like the cells
+///        of the grid, and the frontier is a collections::RadixHeap, so that runs reuse their memory.
+///
+/// @tparam T cell type of the grid
+template <class T> class GridPaths {
+public:
+    /// @param grid grid to search, which must outlive the engine
+    /// @param directional whether states include the direction of the move which reached them
+    explicit GridPaths(const grid::Grid<T>& grid, bool directional = false)
+        : grid_ { &grid }
+        , origin_ { grid.hasBorder() ? grid.stride() + 1 : 0 }
+        , directions_ { directional ? 4U : 1U }
+        , states_ { static_cast<std::size_t>(grid.rows() + (grid.hasBorder() ? 2 : 0))
+              * static_cast<std::size_t>(grid.stride()) * directions_ }
+        , distances_(states_, unreached)
+        , moves_(states_, start_move)
+        , settled_((states_ + 63U) / 64U, 0U)
+    {
+    }
+
+    /// @brief Search from several start states at distance 0 until a goal state is settled
+    ///
+    /// @param starts start states, whose direction is ignored unless directional
+    /// @param cost callback cost(from, to, cell) of the move between two adjacent states, where cell is the
+    ///        value of the cell of @to; a negative cost blocks the move. Moves out of the grid, including
+    ///        into its border, are never proposed.
+    /// @param is_goal predicate on a settled state which stops the search
+    /// @param heuristic lower bound of the distance from a state to the closest goal, which must be
+    ///        consistent: heuristic(from) <= cost(from, to) + heuristic(to)
+    /// @return distance of the first settled goal state, -1 if none is reachable; the distances of every
+    ///         settled state remain available through distance()
+    template <class Cost, class Goal, class Heuristic = NoHeuristic>
+    int run(std::span<const GridState> starts, Cost cost, Goal is_goal, Heuristic heuristic = {})
+    {
+        const auto& grid = *grid_;
+        std::fill(distances_.begin(), distances_.end(), unreached);
+        std::fill(settled_.begin(), settled_.end(), 0U);
+        frontier_.clear();
+
+        for (const auto& start : starts) {
+            if (!grid.inBounds(start.location))
+                continue;
+            const auto id = stateOf(start);
+            distances_[id] = 0U;
+            moves_[id] = start_move;
+            frontier_.push(static_cast<std::uint32_t>(heuristic(start)), id);
+        }
+
+        const auto offsets = grid.neighborOffsets();
+        const auto moves = grid::moveWithDIR();
+        while (!frontier_.empty()) {
+            const auto id = frontier_.pop().second;
+            if (isSettled(id))
+                continue;
+            settled_[id / 64U] |= std::uint64_t { 1U } << (id % 64U);
+
+            const auto from = stateAt(id);
+            const auto distance = distances_[id];
+            if (is_goal(from))
+                return static_cast<int>(distance);
+
+            const auto index = grid.index(from.location);
+            for (std::size_t direction = 0U; direction < offsets.size(); ++direction) {
+                const auto& [step, to_direction] = moves[direction];
+                const GridState to {
+                    { from.location.first + step.first, from.location.second + step.second }, to_direction
+                };
+                if (!grid.inBounds(to.location))
+                    continue;
+                const auto move_cost = cost(from, to, grid[index + offsets[direction]]);
+                if (move_cost < 0)
+                    continue;
+                const auto to_id = stateOf(index + offsets[direction], to.direction);
+                const auto to_distance = distance + static_cast<std::uint32_t>(move_cost);
+                if (to_distance >= distances_[to_id])
+                    continue;
+                distances_[to_id] = to_distance;
+                const auto from_direction = static_cast<std::size_t>(from.direction);
+                moves_[to_id] = static_cast<std::uint8_t>(direction + 4U * from_direction);
+                frontier_.push(to_distance + static_cast<std::uint32_t>(heuristic(to)), to_id);
+            }
+        }
+
+        return -1;
+    }
+
+    template <class Cost, class Goal, class Heuristic = NoHeuristic>
+    int run(const GridState& start, Cost cost, Goal is_goal, Heuristic heuristic = {})
+    {
+        return run(std::span<const GridState>(&start, 1U), cost, is_goal, heuristic);
+    }
+
+    /// @return distance from the starts of the last run to @state, -1 if it was not settled
+    int distance(const GridState& state) const
+    {
+        const auto id = stateOf(state);
+        return isSettled(id) ? static_cast<int>(distances_[id]) : -1;
+    }
+
+    /// @return a shortest path from a start of the last run to @state, both included, empty if not settled
+    std::vector<GridState> path(const GridState& state) const
+    {
+        std::vector<GridState> states {};
+        auto id = stateOf(state);
+        if (!isSettled(id))
+            return states;
+        const auto offsets = grid_->neighborOffsets();
+        for (;;) {
+            states.push_back(stateAt(id));
+            const auto move = moves_[id];
+            if (move == start_move)
+                break;
+            const auto cell = static_cast<std::ptrdiff_t>(directions_ == 1U ? id : id / 4U) - origin_;
+            id = stateOf(cell - offsets[move % 4U], static_cast<grid::Direction>(move / 4U));
+        }
+        std::reverse(states.begin(), states.end());
+        return states;
+    }
+
+private:
+    static constexpr auto unreached = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::uint8_t start_move { 0xffU };
+
+    bool isSettled(std::uint32_t id) const
+    {
+        return (settled_[id / 64U] >> (id % 64U)) & 1U;
+    }
+
+    std::uint32_t stateOf(std::ptrdiff_t index, grid::Direction direction) const
+    {
+        const auto cell = static_cast<std::size_t>(index + origin_);
+        return static_cast<std::uint32_t>(
+            directions_ == 1U ? cell : cell * 4U + static_cast<std::size_t>(direction));
+    }
+
+    std::uint32_t stateOf(const GridState& state) const
+    {
+        return stateOf(grid_->index(state.location), state.direction);
+    }
+
+    GridState stateAt(std::uint32_t id) const
+    {
+        const auto direction = static_cast<grid::Direction>(directions_ == 1U ? 0U : id % 4U);
+        // 32-bit divisions, which are much cheaper than 64-bit ones on many CPUs
+        const auto cell = directions_ == 1U ? id : id / 4U;
+        const auto stride = static_cast<std::uint32_t>(grid_->stride());
+        const auto border = grid_->hasBorder() ? 1 : 0;
+        return { { static_cast<int>(cell / stride) - border, static_cast<int>(cell % stride) - border },
+            direction };
+    }
+
+    const grid::Grid<T>* grid_;
+    std::ptrdiff_t origin_;
+    std::size_t directions_;
+    std::size_t states_;
+    std::vector<std::uint32_t> distances_;
+    /// move which reached each state, as its index in moveWithDIR() + 4 * the direction of its predecessor
+    std::vector<std::uint8_t> moves_;
+    std::vector<std::uint64_t> settled_;
+    collections::RadixHeap<std::uint32_t> frontier_ {};
+};
+
+/// @brief BFS, Dijkstra and bidirectional BFS over user-defined states, e.g. a location, a direction and a
+///        number of steps. States are numbered by a collections::StateStore, and distances and predecessors
+///        are kept in flat arrays indexed by id, so that path() can rebuild a shortest path after a search.
+///
+///        Neighbors are generated by a callback neighbors(state, emit), calling emit(next) for each
+///        neighbor in BFS, or emit(next, cost) with a non-negative integer cost in Dijkstra.
+///
+/// @tparam State state type
+/// @tparam Codec see collections::StateStore
+/// @tparam Hash see collections::StateStore
+template <class State, class Codec = collections::IdentityCodec<State>,
+    class Hash = collections::DefaultHash<typename Codec::key_type>>
+class StateSearch {
+public:
+    /// @brief Breadth-First-Search from @starts until a state satisfying @is_goal is reached
+    /// @return number of steps to the first goal state, -1 if none is reachable
+    template <class Neighbors, class Goal>
+    std::int64_t bfs(std::span<const State> starts, Neighbors neighbors, Goal is_goal)
+    {
+        reset();
+        std::vector<std::uint32_t> frontier {};
+        for (const auto& start : starts)
+            if (const auto id = discover(start, unreached, 0U); id != unreached)
+                frontier.push_back(id);
+
+        for (std::size_t head = 0U; head < frontier.size(); ++head) {
+            const auto id = frontier[head];
+            const auto state = states_[id];
+            if (is_goal(state))
+                return distances_[id];
+            const auto distance = distances_[id] + 1U;
+            neighbors(state, [&](const State& next) {
+                if (const auto next_id = discover(next, id, distance); next_id != unreached)
+                    frontier.push_back(next_id);
+            });
+        }
+
+        return -1;
+    }
+
+    template <class Neighbors, class Goal>
+    std::int64_t bfs(const State& start, Neighbors neighbors, Goal is_goal)
+    {
+        return bfs(std::span<const State>(&start, 1U), neighbors, is_goal);
+    }
+
+    /// @brief Dijkstra's algorithm from @starts until a state satisfying @is_goal is settled,
+    ///        over a collections::RadixHeap: distances must fit in 32 bits
+    /// @return distance to the first settled goal state, -1 if none is reachable
+    template <class Neighbors, class Goal>
+    std::int64_t dijkstra(std::span<const State> starts, Neighbors neighbors, Goal is_goal)
+    {
+        reset();
+        collections::RadixHeap<std::uint32_t> frontier {};
+        for (const auto& start : starts)
+            if (const auto id = discover(start, unreached, 0U); id != unreached)
+                frontier.push(0U, id);
+
+        while (!frontier.empty()) {
+            // distances only decrease strictly, so a state is popped once with its final distance
+            const auto [distance, id] = frontier.pop();
+            if (distance != distances_[id])
+                continue;
+
+            const auto state = states_[id];
+            if (is_goal(state))
+                return distance;
+            neighbors(state, [&, distance = distance, id = id](const State& next, std::uint32_t cost) {
+                const auto next_distance = distance + cost;
+                const auto [next_id, inserted] = states_.insert(next);
+                if (inserted) {
+                    distances_.push_back(next_distance);
+                    predecessors_.push_back(id);
+                } else if (next_distance < distances_[next_id]) {
+                    distances_[next_id] = next_distance;
+                    predecessors_[next_id] = id;
+                } else {
+                    return;
+                }
+                frontier.push(next_distance, next_id);
+            });
+        }
+
+        return -1;
+    }
+
+    template <class Neighbors, class Goal>
+    std::int64_t dijkstra(const State& start, Neighbors neighbors, Goal is_goal)
+    {
+        return dijkstra(std::span<const State>(&start, 1U), neighbors, is_goal);
+    }
+
+    /// @brief BFS alternately from @start and, backwards, from @goal, until the two frontiers meet;
+    ///        this explores about the square root of the states a BFS would for a branching search.
+    ///
+    /// @param reverse_neighbors callback generating the states from which a state can be reached in one step,
+    ///        the same as @neighbors for undirected searches
+    /// @return number of steps from @start to @goal, -1 if it is not reachable
+    template <class Neighbors, class ReverseNeighbors>
+    std::int64_t bidirectionalBfs(
+        const State& start, const State& goal, Neighbors neighbors, ReverseNeighbors reverse_neighbors)
+    {
+        reset();
+        const auto start_id = discover(start, unreached, 0U);
+        if (start == goal)
+            return 0;
+        const auto [goal_id, ignored] = states_.insert(goal);
+        distances_.push_back(0U);
+        predecessors_.push_back(unreached);
+        std::vector<bool> backward { false, true };
+        std::vector<std::uint32_t> forward_frontier { start_id };
+        std::vector<std::uint32_t> backward_frontier { goal_id };
+
+        const auto expand = [&](std::vector<std::uint32_t>& frontier, bool is_backward, auto& generate) {
+            std::vector<std::uint32_t> next_frontier {};
+            std::uint32_t meeting { unreached };
+            for (const auto id : frontier) {
+                const auto distance = distances_[id] + 1U;
+                generate(states_[id], [&](const State& next) {
+                    if (meeting != unreached)
+                        return;
+                    const auto [next_id, inserted] = states_.insert(next);
+                    if (inserted) {
+                        distances_.push_back(distance);
+                        predecessors_.push_back(id);
+                        backward.push_back(is_backward);
+                        next_frontier.push_back(next_id);
+                    } else if (backward[next_id] != is_backward) {
+                        meeting = is_backward ? joinPaths(next_id, id) : joinPaths(id, next_id);
+                    }
+                });
+                if (meeting != unreached)
+                    return meeting;
+            }
+            frontier = std::move(next_frontier);
+            return meeting;
+        };
+
+        while (!forward_frontier.empty() && !backward_frontier.empty()) {
+            const bool go_backward = backward_frontier.size() < forward_frontier.size();
+            const auto meeting = go_backward ? expand(backward_frontier, true, reverse_neighbors)
+                                             : expand(forward_frontier, false, neighbors);
+            if (meeting != unreached)
+                return distances_[goal_id];
+        }
+
+        return -1;
+    }
+
+    template <class Neighbors>
+    std::int64_t bidirectionalBfs(const State& start, const State& goal, Neighbors neighbors)
+    {
+        return bidirectionalBfs(start, goal, neighbors, neighbors);
+    }
+
+    /// @return distance from the starts of the last search to @state, -1 if it was not reached.
+    ///         With Dijkstra, the distance of a state which was not settled may not be the shortest.
+    std::int64_t distance(const State& state) const
+    {
+        const auto* id = states_.find(state);
+        return id == nullptr ? -1 : static_cast<std::int64_t>(distances_[*id]);
+    }
+
+    /// @return the states from a start of the last search to @state, both included, empty if not reached
+    std::vector<State> path(const State& state) const
+    {
+        std::vector<State> states {};
+        const auto* found = states_.find(state);
+        if (found == nullptr)
+            return states;
+        for (auto id = *found; id != unreached; id = predecessors_[id])
+            states.push_back(states_[id]);
+        std::reverse(states.begin(), states.end());
+        return states;
+    }
+
+    /// @brief States reached by the last search, numbered in discovery order
+    const collections::StateStore<State, Codec, Hash>& states() const
+    {
+        return states_;
+    }
+
+private:
+    static constexpr auto unreached = std::numeric_limits<std::uint32_t>::max();
+
+    void reset()
+    {
+        states_.clear();
+        distances_.clear();
+        predecessors_.clear();
+    }
+
+    /// @return id of @state if it was not reached yet, unreached otherwise
+    std::uint32_t discover(const State& state, std::uint32_t predecessor, std::uint32_t distance)
+    {
+        const auto [id, inserted] = states_.insert(state);
+        if (!inserted)
+            return unreached;
+        distances_.push_back(distance);
+        predecessors_.push_back(predecessor);
+        return id;
+    }
+
+    /// @brief Link the backward half of a bidirectional path, from @backward_id to the goal, after the
+    ///        forward half ending in @forward_id, so that predecessors and distances describe a single search
+    /// @return @backward_id
+    std::uint32_t joinPaths(std::uint32_t forward_id, std::uint32_t backward_id)
+    {
+        auto previous = forward_id;
+        for (auto id = backward_id; id != unreached;) {
+            const auto next = predecessors_[id];
+            predecessors_[id] = previous;
+            distances_[id] = distances_[previous] + 1U;
+            previous = id;
+            id = next;
+        }
+        return backward_id;
+    }
+
+    collections::StateStore<State, Codec, Hash> states_ {};
+    std::vector<std::uint32_t> distances_ {};
+    std::vector<std::uint32_t> predecessors_ {};
+};
+
+/// @brief Result of simulate
+template <class State> struct Simulation {
+    /// state after the requested number of steps
+    State state {};
+    /// first step of the cycle, and its length; 0 if no state repeated within the simulated steps
+    std::size_t cycle_start { 0U };
+    std::size_t period { 0U };
+};
+
+/// @brief Apply @step to @initial @steps times, stopping at the first repeated state:
+///        the state after @steps is then extrapolated from the period of the cycle.
+///        States are numbered by a collections::StateStore, so that the id of a state is the step it was
+///        first seen at.
+///
+/// @param initial state at step 0
+/// @param step callback returning the state following its argument
+/// @param steps number of steps, e.g. 1'000'000'000
+template <class State, class Codec = collections::IdentityCodec<State>,
+    class Hash = collections::DefaultHash<typename Codec::key_type>, class Step>
+Simulation<State> simulate(const State& initial, Step step, std::size_t steps)
+{
+    collections::StateStore<State, Codec, Hash> seen {};
+    seen.insert(initial);
+    auto state = initial;
+    for (std::size_t time = 1U; time <= steps; ++time) {
+        state = step(state);
+        const auto [id, inserted] = seen.insert(state);
+        if (!inserted) {
+            const std::size_t period = time - id;
+            return { seen[static_cast<std::uint32_t>(id + (steps - id) % period)], id, period };
+        }
+    }
+    return { state, 0U, 0U };
 }
 
 } // namespace algorithms
@@ -1,14 +1,21 @@
 #include "../pypp.hpp"
 #include "gtest/gtest.h"
+#include <cctype>
+#include <cmath>
 #include <filesystem>
+#include <numeric>
+#include <queue>
+#include <random>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include <string>
+#include <thread>
 #include <tuple>
 #include <vector>
 
 using strings = std::vector<std::string>;
+using algorithms::SearchMode;
 
 /// @brief Fixture class to facilitate parameterized tests of lstripDigit
 class LStripDigitFixture : public testing::TestWithParam<std::tuple<std::string, std::string>> { };
@@ -132,6 +139,55 @@ INSTANTIATE_TEST_SUITE_P(RStripTests, RStripFixture,
     testing::Values(std::make_tuple("a1b2c3", "a1b2c3"), std::make_tuple("a1b2c3 ", "a1b2c3"),
         std::make_tuple("a1b2c3  ", "a1b2c3"), std::make_tuple("", "")));
 
+static_assert(pypp::strip(std::string_view { " \tab c\n" }, pypp::chars::space) == "ab c");
+static_assert(pypp::lstripDigit(std::string_view { "123abc456" }) == "abc456");
+static_assert(pypp::rstripAlpha(std::string_view { "123abc" }) == "123");
+static_assert(pypp::CharClass::range('\x80', '\xff')('\xff'));
+static_assert(!pypp::CharClass::range('\x80', '\xff')('\x7f'));
+static_assert(pypp::CharClass::range('\0', '\xff')('\0') && pypp::CharClass::range('\xff', '\xff')('\xff'));
+
+struct StripViewRecord {
+    std::string sample;
+    pypp::CharClass char_class;
+    std::string expected_lstrip;
+    std::string expected_rstrip;
+    std::string expected_strip;
+};
+
+/// @brief Fixture class to facilitate parameterized tests of the string_view and in-place strip family
+class StripViewFixture : public testing::TestWithParam<StripViewRecord> { };
+
+TEST_P(StripViewFixture, GivenString_WhenStrippingViewOrInPlace_ExpectSameResultAsCopy)
+{
+    // Given
+    const auto& param = GetParam();
+    const std::string_view view { param.sample };
+    std::string in_place { param.sample };
+
+    // When
+    const auto l = pypp::lstrip(view, param.char_class);
+    const auto r = pypp::rstrip(view, param.char_class);
+    const auto lr = pypp::strip(view, param.char_class);
+    pypp::stripInPlace(in_place, param.char_class);
+
+    // Then
+    ASSERT_EQ(l, param.expected_lstrip);
+    ASSERT_EQ(r, param.expected_rstrip);
+    ASSERT_EQ(lr, param.expected_strip);
+    ASSERT_EQ(in_place, param.expected_strip);
+    ASSERT_EQ(pypp::strip(param.sample, param.char_class), param.expected_strip);
+    ASSERT_TRUE(lr.empty() || (lr.data() >= view.data() && lr.end() <= view.end()));
+}
+
+INSTANTIATE_TEST_SUITE_P(StripViewTests, StripViewFixture,
+    testing::Values(StripViewRecord { "12ab34", pypp::chars::digit, "ab34", "12ab", "ab" },
+        StripViewRecord { "ab12cd", pypp::chars::alpha, "12cd", "ab12", "12" },
+        StripViewRecord { " \t a b \n", pypp::chars::space, "a b \n", " \t a b", "a b" },
+        StripViewRecord { "x=12, ", pypp::CharClass { "x=, " }, "12, ", "x=12", "12" },
+        StripViewRecord { "1234", pypp::chars::digit, "", "", "" },
+        StripViewRecord { "", pypp::chars::alpha, "", "", "" },
+        StripViewRecord { "\xe9t\xe9", pypp::chars::alpha, "\xe9t\xe9", "\xe9t\xe9", "\xe9t\xe9" }));
+
 struct SplitRecord {
     std::string sample;
     char split_on;
@@ -167,6 +223,115 @@ const std::vector<SplitRecord> split_records
 
 INSTANTIATE_TEST_SUITE_P(SplitTests, SplitFixture, testing::ValuesIn(split_records));
 
+/// @brief Fixture class to facilitate parameterized tests of splitView
+class SplitViewFixture : public testing::TestWithParam<SplitRecord> { };
+
+TEST_P(SplitViewFixture, GivenString_WhenSplittingViewOnSomechar_ExpectSameResultAsSplit)
+{
+    // Given
+    const std::string& sample = GetParam().sample;
+    const strings expected = GetParam().expected;
+
+    // When
+    const auto result = pypp::splitView(sample, GetParam().split_on, GetParam().at_most);
+
+    // Then
+    ASSERT_EQ(strings(result.begin(), result.end()), expected);
+    for (const auto token : result)
+        ASSERT_TRUE(token.data() >= sample.data() && token.end() <= std::string_view(sample).end());
+}
+
+INSTANTIATE_TEST_SUITE_P(SplitViewTests, SplitViewFixture, testing::ValuesIn(split_records));
+
+TEST(SplitRangeTest, GivenString_WhenIteratingLazily_ExpectNonEmptyTokensInOrder)
+{
+    // Given
+    const std::string sample { ",,ab,,c,def," };
+
+    // When
+    strings result {};
+    for (const auto token : pypp::splitRange(sample, ','))
+        result.emplace_back(token);
+
+    // Then
+    ASSERT_EQ(result, (strings { "ab", "c", "def" }));
+    ASSERT_TRUE(pypp::splitRange(",,,", ',').empty());
+}
+
+TEST(SplitThenGetAtTest, GivenString_WhenGettingAtIndex_ExpectCorrectSubstringOrThrow)
+{
+    // Given
+    const std::string sample { "move 3 from 5 to 7" };
+
+    // When / Then
+    ASSERT_EQ(pypp::splitThenGetAt(sample, ' ', 0), "move");
+    ASSERT_EQ(pypp::splitThenGetAt(sample, ' ', 5), "7");
+    ASSERT_THROW(pypp::splitThenGetAt(sample, ' ', 6), std::out_of_range);
+}
+
+/// @brief Fixture class to compare the vectorized delimiter scanner against the scalar one
+class DelimiterScanFixture : public testing::TestWithParam<std::string> { };
+
+TEST_P(DelimiterScanFixture, GivenRandomString_WhenScanningForDelimiters_ExpectVectorMatchesScalar)
+{
+    // Given
+    const pypp::Delimiters delims { GetParam() };
+    std::mt19937 rng { 42U };
+    std::uniform_int_distribution<int> pick_char { 0, 255 };
+    std::uniform_int_distribution<std::size_t> pick_len { 0U, 300U };
+
+    for (int round = 0; round < 200; ++round) {
+        std::string sample(pick_len(rng), '\0');
+        for (auto& ch : sample)
+            ch = (pick_char(rng) % 8 == 0 && !GetParam().empty())
+                ? GetParam()[pick_char(rng) % GetParam().size()]
+                : static_cast<char>(pick_char(rng));
+
+        for (std::size_t from = 0U; from <= sample.size(); ++from) {
+            // When
+            const auto scalar = pypp::detail::findFirstOfScalar(sample, from, delims);
+            const auto vector = pypp::detail::findFirstOfVector(sample, from, delims);
+
+            // Then
+            ASSERT_EQ(scalar, vector);
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(DelimiterScanTests, DelimiterScanFixture,
+    testing::Values(std::string { "\n" }, std::string { " ,;" }, std::string { "\x80\xff\x00", 3U },
+        std::string { "abcdefghijklmnop" }, std::string { "abcdefghijklmnopq" }, std::string {}));
+
+TEST(SplitTest, GivenString_WhenSplittingOnSeveralDelimiters_ExpectSameResultAsChainedSplits)
+{
+    // Given
+    const std::string sample { "foo;ba, r,  ,dead, c;ode$be; ef" };
+
+    // When
+    const auto result = pypp::split(sample, " ,;");
+
+    // Then
+    strings expected {};
+    for (const auto& by_comma : pypp::split(sample, ','))
+        for (const auto& by_semicolon : pypp::split(by_comma, ';'))
+            for (const auto& by_space : pypp::split(by_semicolon, ' '))
+                expected.push_back(by_space);
+    ASSERT_EQ(result, expected);
+    ASSERT_EQ(pypp::splitView(sample, " ,;", 3).size(), 3U);
+}
+
+TEST(SplitLinesViewTest, GivenMultilineString_WhenSplittingLinesView_ExpectBlankLinesDropped)
+{
+    // Given
+    const std::string sample { "111\n222\n\n333\n" };
+
+    // When
+    const auto result = pypp::splitLinesView(sample);
+
+    // Then
+    ASSERT_EQ(strings(result.begin(), result.end()), pypp::splitLines(sample));
+}
+
 struct SplitFileLinesRecord {
     std::string filepath;
     strings expected;
@@ -201,6 +366,1843 @@ const std::vector<SplitFileLinesRecord> split_file_lines_records
 INSTANTIATE_TEST_CASE_P(
     SplitFilesLinesTess, SplitFileLinesFixture, testing::ValuesIn(split_file_lines_records));
 
+/// @brief Write @contents to a fresh file in the temporary directory and return its path
+std::string writeTempFile(const std::string& name, const std::string& contents)
+{
+    const auto path = fs::temp_directory_path() / ("pypp_test_" + name);
+    std::ofstream out_f(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    out_f << contents;
+    return path.string();
+}
+
+struct MappedFileLinesRecord {
+    std::string contents;
+    pypp::LinesOptions options;
+    strings expected;
+};
+
+/// @brief Fixture class to facilitate parameterized tests of MappedFile::lines
+class MappedFileLinesFixture : public testing::TestWithParam<MappedFileLinesRecord> { };
+
+TEST_P(MappedFileLinesFixture, GivenFile_WhenIteratingLines_ExpectCorrectResult)
+{
+    // Given
+    const auto path = writeTempFile("mapped_lines.txt", GetParam().contents);
+    const pypp::MappedFile file(path);
+
+    // When
+    strings result {};
+    for (const auto line : file.lines(GetParam().options))
+        result.emplace_back(line);
+
+    // Then
+    ASSERT_TRUE(file.isOpen());
+    ASSERT_EQ(file.view(), GetParam().contents);
+    ASSERT_EQ(result, GetParam().expected);
+}
+
+const std::vector<MappedFileLinesRecord> mapped_file_lines_records
+    = { { "111\n222\n\n444\n", {}, { "111", "222", "444" } },
+          { "111\n222\n\n444", { false, true }, { "111", "222", "", "444" } },
+          { "111\n\n", { false, true }, { "111", "" } }, { "", {}, { "" } }, { "", { true, false }, {} },
+          { "\n\n\n", {}, { "" } }, { "\n\n\n", { true, false }, {} }, { "\n", { false, false }, { "" } } };
+
+INSTANTIATE_TEST_SUITE_P(
+    MappedFileLinesTests, MappedFileLinesFixture, testing::ValuesIn(mapped_file_lines_records));
+
+TEST(MappedFileTest, GivenMissingFile_WhenOpening_ExpectErrorStatus)
+{
+    // Given
+    const std::string path { "/this/path/does/not/exist.txt" };
+
+    // When
+    const pypp::MappedFile file(path);
+    std::error_code ec {};
+    const auto lines = pypp::splitFileLines(path, ec);
+
+    // Then
+    ASSERT_FALSE(file.isOpen());
+    ASSERT_EQ(file.error(), std::errc::no_such_file_or_directory);
+    ASSERT_EQ(ec, std::errc::no_such_file_or_directory);
+    ASSERT_EQ(lines, (strings { "" }));
+}
+
+TEST(MappedFileTest, GivenRegularFile_WhenSplittingFileLines_ExpectSameResultAsGetline)
+{
+    // Given
+    const std::string contents { "111\n222\n\n444\n555" };
+    const auto path = writeTempFile("split_file_lines.txt", contents);
+
+    // When
+    std::error_code ec {};
+    const auto result = pypp::splitFileLines(path, ec);
+
+    // Then
+    ASSERT_FALSE(ec);
+    ASSERT_EQ(result, (strings { "111", "222", "444", "555" }));
+}
+
+#if defined(__linux__)
+TEST(MappedFileTest, GivenPipe_WhenOpening_ExpectBufferedFallback)
+{
+    // Given
+    int fds[2] {};
+    ASSERT_EQ(::pipe(fds), 0);
+    const std::string contents { "aaa\nbbb\n" };
+    ASSERT_EQ(::write(fds[1], contents.data(), contents.size()), static_cast<ssize_t>(contents.size()));
+    ::close(fds[1]);
+
+    // When
+    const pypp::MappedFile file("/dev/fd/" + std::to_string(fds[0]));
+    ::close(fds[0]);
+
+    // Then
+    ASSERT_TRUE(file.isOpen());
+    ASSERT_FALSE(file.isMapped());
+    ASSERT_EQ(file.view(), contents);
+}
+
+TEST(MappedFileTest, GivenRegularFileRedirectedToStdin_WhenOpeningDash_ExpectBufferedAndStdinKept)
+{
+    // Given
+    const std::string contents { "skipped\nkept\n" };
+    const auto path = writeTempFile("stdin_redirect.txt", contents);
+    const int saved_stdin = ::dup(STDIN_FILENO);
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    ASSERT_GE(saved_stdin, 0);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(::dup2(fd, STDIN_FILENO), STDIN_FILENO);
+    ::close(fd);
+    char skipped[8] {};
+    ASSERT_EQ(::read(STDIN_FILENO, skipped, sizeof(skipped)), static_cast<ssize_t>(sizeof(skipped)));
+
+    // When
+    const pypp::MappedFile file("-");
+    const bool stdin_open = ::fcntl(STDIN_FILENO, F_GETFD) != -1;
+    ::dup2(saved_stdin, STDIN_FILENO);
+    ::close(saved_stdin);
+
+    // Then
+    ASSERT_TRUE(stdin_open);
+    ASSERT_TRUE(file.isOpen());
+    ASSERT_FALSE(file.isMapped());
+    ASSERT_EQ(file.view(), "kept\n");
+}
+
+TEST(MappedFileTest, GivenMissingFile_WhenMovingMappedFile_ExpectMovedFromErrorCleared)
+{
+    // Given
+    pypp::MappedFile file("/this/path/does/not/exist.txt");
+
+    // When
+    const pypp::MappedFile moved(std::move(file));
+
+    // Then
+    ASSERT_EQ(moved.error(), std::errc::no_such_file_or_directory);
+    ASSERT_FALSE(file.error());
+    ASSERT_TRUE(file.view().empty());
+}
+
+TEST(MappedFileTest, GivenShortPipeInput_WhenMovingLineIndex_ExpectLinesStillValid)
+{
+    // Given
+    int fds[2] {};
+    ASSERT_EQ(::pipe(fds), 0);
+    const std::string contents { "ab\ncd\n" };
+    ASSERT_EQ(::write(fds[1], contents.data(), contents.size()), static_cast<ssize_t>(contents.size()));
+    ::close(fds[1]);
+    auto index = pypp::parallelSplitFileLines("/dev/fd/" + std::to_string(fds[0]));
+    ::close(fds[0]);
+
+    // When
+    std::vector<pypp::LineIndex> indexes {};
+    indexes.push_back(std::move(index));
+    indexes.emplace_back();
+
+    // Then
+    ASSERT_FALSE(indexes.front().file.isMapped());
+    ASSERT_EQ(indexes.front().file.view(), contents);
+    ASSERT_EQ(indexes.front().lines, (std::vector<std::string_view> { "ab", "cd" }));
+    ASSERT_EQ(indexes.front().lines.front().data(), indexes.front().file.view().data());
+}
+#endif
+
+/// @brief Fixture class to facilitate parameterized tests of parallelSplitFileLines
+class ParallelSplitFileLinesFixture : public testing::TestWithParam<unsigned> { };
+
+TEST_P(ParallelSplitFileLinesFixture, GivenFile_WhenSplittingInParallel_ExpectSameResultForEveryChunkSize)
+{
+    // Given
+    const std::string contents { "111\n22\n\n\n4444\n5\n\n666666\n7\n" };
+    const auto path = writeTempFile("parallel_lines.txt", contents);
+    const auto expected = pypp::splitFileLines(path);
+
+    for (std::size_t chunk_size = 1U; chunk_size <= contents.size() + 1U; ++chunk_size) {
+        // When
+        const auto index = pypp::parallelSplitFileLines(path, {}, { chunk_size, GetParam() });
+        const auto with_blanks
+            = pypp::parallelSplitLines(contents, { false, true }, { chunk_size, GetParam() });
+
+        // Then
+        ASSERT_TRUE(index.file.isOpen());
+        ASSERT_EQ(strings(index.lines.begin(), index.lines.end()), expected);
+        const auto line_range = pypp::LineRange(contents, { false, true });
+        ASSERT_TRUE(std::ranges::equal(with_blanks, line_range));
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ParallelSplitFileLinesTests, ParallelSplitFileLinesFixture, testing::Values(1U, 2U, 8U));
+
+TEST(ParallelSplitLinesTest, GivenEmptyBuffer_WhenSplittingInParallel_ExpectOneEmptyLine)
+{
+    // Given
+    const std::string contents { "\n\n" };
+
+    // When
+    const auto lines = pypp::parallelSplitLines(contents, {}, { 1U, 4U });
+
+    // Then
+    ASSERT_EQ(strings(lines.begin(), lines.end()), (strings { "" }));
+}
+
+TEST(MapChunksTest, GivenBuffer_WhenParsingChunks_ExpectResultsInChunkOrder)
+{
+    // Given
+    std::string contents {};
+    for (int i = 0; i < 1000; ++i)
+        contents += std::to_string(i) + "\n";
+
+    // When
+    const auto sums = pypp::mapChunks(
+        contents,
+        [](std::string_view chunk) {
+            long sum { 0 };
+            for (const auto line : pypp::LineRange(chunk))
+                sum += std::stol(std::string(line));
+            return sum;
+        },
+        { 64U, 4U });
+
+    // Then
+    ASSERT_GT(sums.size(), 1U);
+    ASSERT_EQ(std::accumulate(sums.begin(), sums.end(), 0L), 999L * 1000L / 2L);
+}
+
+TEST(CounterTest, GivenRange_WhenAccessingKeys_ExpectCountsAndZeroForUnseenKeys)
+{
+    // Given
+    const std::string sample { "abracadabra" };
+    collections::Counter<char> counter(sample.begin(), sample.end());
+
+    // When
+    counter['z'] += 2;
+    counter['a'] += 1;
+
+    // Then
+    ASSERT_EQ(counter['a'], 6);
+    ASSERT_EQ(counter['b'], 2);
+    ASSERT_EQ(counter['q'], 0);
+    ASSERT_EQ(counter['z'], 2);
+    ASSERT_EQ(counter.size(), 7U);
+    ASSERT_EQ(counter.total(), 14);
+}
+
+/// @brief Fixture class to run the same Counter tests against every storage
+template <class CounterType> class CounterStorageFixture : public testing::Test { };
+
+using CounterStorages = testing::Types<collections::Counter<std::string>,
+    collections::Counter<std::string, std::hash<std::string>, collections::FlatStorage>>;
+TYPED_TEST_SUITE(CounterStorageFixture, CounterStorages);
+
+TYPED_TEST(CounterStorageFixture, GivenTokens_WhenCounting_ExpectViewsConsistentWithCounts)
+{
+    // Given
+    const strings tokens { pypp::split("a b c a b a d e a", ' ') };
+
+    // When
+    TypeParam counter(tokens.begin(), tokens.end());
+    for (auto& count : counter.values())
+        count *= 10;
+
+    // Then
+    ASSERT_EQ(counter.size(), 5U);
+    ASSERT_EQ(counter.total(), 90);
+    ASSERT_EQ(counter["a"], 40);
+    ASSERT_EQ(std::ranges::distance(counter.keys()), 5);
+    for (const auto& [key, count] : counter.items())
+        ASSERT_EQ(count, counter.getUnderlyingMap().at(key));
+    ASSERT_EQ(counter.mostCommon(1), (std::vector<std::pair<std::string, int>> { { "a", 40 } }));
+}
+
+TYPED_TEST(CounterStorageFixture, GivenTies_WhenGettingMostCommon_ExpectCountThenKeyOrder)
+{
+    // Given
+    const strings tokens { pypp::split("d c b a c b a b a a e", ' ') };
+    TypeParam counter(tokens.begin(), tokens.end());
+
+    // When
+    const auto top3 = counter.mostCommon(3);
+    const auto all = counter.mostCommon();
+
+    // Then
+    using Items = std::vector<std::pair<std::string, int>>;
+    ASSERT_EQ(top3, (Items { { "a", 4 }, { "b", 3 }, { "c", 2 } }));
+    ASSERT_EQ(all, (Items { { "a", 4 }, { "b", 3 }, { "c", 2 }, { "d", 1 }, { "e", 1 } }));
+    ASSERT_EQ(counter.mostCommon(200), all);
+}
+
+TYPED_TEST(CounterStorageFixture, GivenCounts_WhenIteratingElements_ExpectEachKeyRepeatedByItsPositiveCount)
+{
+    // Given
+    TypeParam counter {};
+    counter["x"] = 3;
+    counter["y"] = 0;
+    counter["z"] = -2;
+    counter["w"] = 1;
+
+    // When
+    strings elements {};
+    for (const auto& element : counter.elements())
+        elements.push_back(element);
+
+    // Then
+    std::sort(elements.begin(), elements.end());
+    ASSERT_EQ(elements, (strings { "w", "x", "x", "x" }));
+}
+
+TYPED_TEST(CounterStorageFixture, GivenTwoCounters_WhenCombining_ExpectPythonCounterSemantics)
+{
+    // Given
+    using Items = std::vector<std::pair<std::string, int>>;
+    const strings lhs_tokens { pypp::split("a a a b b c", ' ') };
+    const strings rhs_tokens { pypp::split("a b b b d", ' ') };
+    const TypeParam lhs(lhs_tokens.begin(), lhs_tokens.end());
+    const TypeParam rhs(rhs_tokens.begin(), rhs_tokens.end());
+
+    // When
+    auto subtracted = lhs;
+    subtracted.subtract(rhs);
+    auto updated = lhs;
+    updated.update(rhs_tokens.begin(), rhs_tokens.end());
+
+    // Then
+    ASSERT_EQ(subtracted.mostCommon(), (Items { { "a", 2 }, { "c", 1 }, { "b", -1 }, { "d", -1 } }));
+    ASSERT_EQ(updated.mostCommon(), (Items { { "b", 5 }, { "a", 4 }, { "c", 1 }, { "d", 1 } }));
+    ASSERT_EQ((lhs + rhs).mostCommon(), updated.mostCommon());
+    ASSERT_EQ((lhs - rhs).mostCommon(), (Items { { "a", 2 }, { "c", 1 } }));
+    ASSERT_EQ((lhs | rhs).mostCommon(), (Items { { "a", 3 }, { "b", 3 }, { "c", 1 }, { "d", 1 } }));
+    ASSERT_EQ((lhs & rhs).mostCommon(), (Items { { "b", 2 }, { "a", 1 } }));
+    ASSERT_EQ((subtracted + TypeParam {}).mostCommon(), (Items { { "a", 2 }, { "c", 1 } }));
+}
+
+TYPED_TEST(CounterStorageFixture, GivenManyPartialCounters_WhenReducing_ExpectSumOfCounts)
+{
+    // Given
+    std::vector<TypeParam> partials {};
+    TypeParam expected {};
+    for (int i = 0; i < 37; ++i) {
+        TypeParam partial {};
+        for (int j = 0; j <= i; ++j)
+            partial[std::to_string(j % 11)] += j;
+        expected.update(partial);
+        partials.push_back(std::move(partial));
+    }
+
+    // When
+    const auto reduced = TypeParam::reduce(std::move(partials), 4U);
+
+    // Then
+    ASSERT_EQ(reduced.mostCommon(), expected.mostCommon());
+    ASSERT_EQ(TypeParam::reduce({}).size(), 0U);
+}
+
+TEST(FlatMapTest, GivenInsertionsAndErasures_WhenReusingSlots_ExpectSameContentsAsUnorderedMap)
+{
+    // Given
+    collections::FlatMap<int, int> flat {};
+    std::unordered_map<int, int> reference {};
+    std::mt19937 rng { 11U };
+    std::uniform_int_distribution<int> pick_key { 0, 300 };
+
+    // When
+    for (int i = 0; i < 100000; ++i) {
+        const auto key = pick_key(rng);
+        if (i % 3 == 0) {
+            ASSERT_EQ(flat.erase(key), reference.erase(key));
+        } else {
+            flat[key] += 1;
+            reference[key] += 1;
+        }
+    }
+    erase_if(flat, [](const auto& item) { return item.second % 2 == 0; });
+    std::erase_if(reference, [](const auto& item) { return item.second % 2 == 0; });
+
+    // Then
+    ASSERT_EQ(flat.size(), reference.size());
+    ASSERT_LE(flat.capacity(), 1024U);
+    for (const auto& [key, value] : flat)
+        ASSERT_EQ(reference.at(key), value);
+}
+
+TEST(CounterTest, GivenDenseCounters_WhenCombining_ExpectOnlyPositiveCountsKept)
+{
+    // Given
+    const std::string lhs_chars { "aaabbc" };
+    const std::string rhs_chars { "abbbd" };
+    const collections::Counter<char> lhs(lhs_chars.begin(), lhs_chars.end());
+    const collections::Counter<char> rhs(rhs_chars.begin(), rhs_chars.end());
+
+    // When
+    const auto difference = lhs - rhs;
+    const auto intersection = lhs & rhs;
+
+    // Then
+    using Items = std::vector<std::pair<char, int>>;
+    ASSERT_EQ(difference.mostCommon(), (Items { { 'a', 2 }, { 'c', 1 } }));
+    ASSERT_EQ(intersection.mostCommon(), (Items { { 'b', 2 }, { 'a', 1 } }));
+    ASSERT_EQ(intersection.size(), 2U);
+}
+
+TEST(CounterTest, GivenMoreThan127Keys_WhenGettingMostCommon_ExpectNoTruncation)
+{
+    // Given
+    std::vector<int> values {};
+    for (int key = 0; key < 300; ++key)
+        for (int i = 0; i <= key % 7; ++i)
+            values.push_back(key);
+    const collections::Counter<int> counter(values.begin(), values.end());
+
+    // When
+    const auto top = counter.mostCommon(200);
+
+    // Then
+    ASSERT_EQ(top.size(), 200U);
+    ASSERT_EQ(top.front(), std::make_pair(6, 7));
+    ASSERT_TRUE(std::is_sorted(top.begin(), top.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.second > rhs.second || (lhs.second == rhs.second && lhs.first < rhs.first);
+    }));
+}
+
+/// @brief Fixture class to facilitate parameterized stress tests of ConcurrentCounter
+class ConcurrentCounterFixture : public testing::TestWithParam<bool> { };
+
+TEST_P(ConcurrentCounterFixture, GivenSeveralThreads_WhenAddingSharedKeys_ExpectExactTotals)
+{
+    // Given
+    constexpr int n_threads { 8 };
+    constexpr int adds_per_thread { 20000 };
+    constexpr int n_keys { 17 };
+    const bool use_writer = GetParam();
+    collections::ConcurrentCounter<int> counter { 4U };
+
+    // When
+    std::vector<std::thread> threads {};
+    for (int t = 0; t < n_threads; ++t)
+        threads.emplace_back([&, t]() {
+            auto writer = counter.writer(5U);
+            for (int i = 0; i < adds_per_thread; ++i) {
+                if (use_writer)
+                    writer.add((i + t) % n_keys);
+                else
+                    counter.add((i + t) % n_keys);
+            }
+        });
+    for (auto& thread : threads)
+        thread.join();
+
+    // Then
+    auto snapshot = counter.snapshot();
+    ASSERT_EQ(counter.total(), n_threads * adds_per_thread);
+    ASSERT_EQ(snapshot.total(), n_threads * adds_per_thread);
+    ASSERT_EQ(snapshot.size(), static_cast<std::size_t>(n_keys));
+    for (int key = 0; key < n_keys; ++key) {
+        int expected { 0 };
+        for (int t = 0; t < n_threads; ++t)
+            for (int i = 0; i < adds_per_thread; ++i)
+                expected += (i + t) % n_keys == key;
+        ASSERT_EQ(snapshot[key], expected);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(ConcurrentCounterTests, ConcurrentCounterFixture, testing::Values(false, true));
+
+TEST(ConcurrentCounterTest, GivenPerThreadCounters_WhenMerging_ExpectSumOfCounts)
+{
+    // Given
+    const strings words { "a", "b", "a" };
+    collections::Counter<std::string> partial(words.begin(), words.end());
+    collections::ConcurrentCounter<std::string> counter {};
+    collections::ConcurrentCounter<std::string> other {};
+    other.add("c", 5);
+
+    // When
+    counter.merge(partial);
+    counter.merge(partial);
+    counter.merge(other);
+
+    // Then
+    auto snapshot = counter.snapshot();
+    ASSERT_EQ(snapshot["a"], 4);
+    ASSERT_EQ(snapshot["b"], 2);
+    ASSERT_EQ(snapshot["c"], 5);
+    ASSERT_EQ(counter.total(), 11);
+}
+
+TEST(ConcurrentCounterTest, GivenFlatShards_WhenAddingKeys_ExpectSameCountsForAnyShardCount)
+{
+    // Given
+    using FlatConcurrentCounter
+        = collections::ConcurrentCounter<int, std::hash<int>, collections::FlatStorage>;
+    FlatConcurrentCounter single { 1U };
+    FlatConcurrentCounter striped { 64U };
+
+    // When
+    for (int key = 0; key < 10'000; ++key) {
+        single.add(key % 3'000);
+        striped.add(key % 3'000);
+    }
+
+    // Then
+    ASSERT_EQ(single.snapshot().getUnderlyingMap(), striped.snapshot().getUnderlyingMap());
+    ASSERT_EQ(striped.snapshot().size(), 3'000U);
+    ASSERT_EQ(striped.total(), 10'000);
+}
+
+/// @brief Draw @n samples of a Zipfian distribution over @n_keys keys, with exponent @s
+std::vector<int> zipfianStream(std::size_t n, int n_keys, double s, unsigned seed)
+{
+    std::vector<double> weights {};
+    for (int k = 1; k <= n_keys; ++k)
+        weights.push_back(1.0 / std::pow(k, s));
+
+    std::mt19937 rng { seed };
+    std::discrete_distribution<int> pick_key(weights.begin(), weights.end());
+    std::vector<int> stream(n);
+    for (auto& key : stream)
+        key = pick_key(rng);
+
+    return stream;
+}
+
+TEST(SpaceSavingTest, GivenZipfianStream_WhenTrackingHeavyHitters_ExpectHighRecallWithinErrorBounds)
+{
+    // Given
+    const auto stream = zipfianStream(200000U, 50000, 1.1, 1234U);
+    collections::Counter<int> exact(stream.begin(), stream.end());
+    constexpr std::size_t k { 20U };
+
+    // When
+    const collections::SpaceSaving<int> approx(500U, stream.begin(), stream.end());
+
+    // Then
+    const auto exact_top = exact.mostCommon(k);
+    const auto approx_top = approx.mostCommon(k);
+    std::size_t hits { 0U };
+    for (const auto& [key, count] : exact_top)
+        hits += std::ranges::count(approx_top, key, &std::pair<int, std::int64_t>::first);
+    const auto recall = static_cast<double>(hits) / k;
+    RecordProperty("recall_at_20", std::to_string(recall));
+    ASSERT_GE(recall, 0.95);
+
+    ASSERT_EQ(approx.total(), static_cast<std::int64_t>(stream.size()));
+    ASSERT_LE(approx.size(), approx.capacity());
+    ASSERT_LE(approx.minCount(), approx.total() / static_cast<std::int64_t>(approx.capacity()));
+    for (const auto& [key, count] : approx.mostCommon()) {
+        ASSERT_GE(count, exact[key]);
+        ASSERT_LE(count - approx.error(key), exact[key]);
+    }
+    for (const auto& [key, count] : exact.items()) {
+        if (count > approx.total() / static_cast<std::int64_t>(approx.capacity())) {
+            ASSERT_GT(approx[key], 0);
+        }
+    }
+}
+
+TEST(CountMinSketchTest, GivenZipfianStream_WhenEstimating_ExpectOverestimatesWithinErrorBound)
+{
+    // Given
+    const auto stream = zipfianStream(200000U, 50000, 1.1, 99U);
+    collections::Counter<int> exact(stream.begin(), stream.end());
+    constexpr double epsilon { 0.001 };
+
+    // When
+    auto sketch = collections::CountMinSketch<int>::withErrorBounds(epsilon, 0.01);
+    for (const auto key : stream)
+        sketch.add(key);
+
+    // Then
+    ASSERT_EQ(sketch.total(), static_cast<std::int64_t>(stream.size()));
+    std::size_t within_bound { 0U };
+    for (const auto& [key, count] : exact.items()) {
+        ASSERT_GE(sketch[key], count);
+        within_bound += sketch[key] - count <= epsilon * sketch.total();
+    }
+    ASSERT_GE(static_cast<double>(within_bound) / exact.size(), 0.99);
+}
+
+TEST(CountMinSketchTest, GivenInvalidErrorBounds_WhenSizing_ExpectInvalidArgument)
+{
+    // Given
+    using Sketch = collections::CountMinSketch<int>;
+    constexpr auto nan = std::numeric_limits<double>::quiet_NaN();
+
+    // When / Then
+    ASSERT_THROW(Sketch::withErrorBounds(0.0, 0.01), std::invalid_argument);
+    ASSERT_THROW(Sketch::withErrorBounds(-0.1, 0.01), std::invalid_argument);
+    ASSERT_THROW(Sketch::withErrorBounds(nan, 0.01), std::invalid_argument);
+    ASSERT_THROW(Sketch::withErrorBounds(0.01, 0.0), std::invalid_argument);
+    ASSERT_THROW(Sketch::withErrorBounds(0.01, 1.0), std::invalid_argument);
+    ASSERT_THROW(Sketch::withErrorBounds(0.01, nan), std::invalid_argument);
+    ASSERT_NO_THROW(Sketch::withErrorBounds(0.01, 0.5));
+}
+
+TEST(DenseStorageTest, GivenLargeByteBuffer_WhenCounting_ExpectSameResultsAsNodeStorage)
+{
+    // Given
+    std::string buffer(10'000'019U, '\0');
+    std::mt19937 rng { 3U };
+    std::geometric_distribution<int> pick_byte { 0.05 };
+    for (auto& ch : buffer)
+        ch = static_cast<char>(pick_byte(rng) % 256);
+
+    // When
+    const collections::Counter<char> dense(buffer.begin(), buffer.end());
+    using NodeCounter = collections::Counter<char, std::hash<char>, collections::NodeStorage>;
+    const NodeCounter node(buffer.begin(), buffer.end());
+    const collections::Counter<char> threaded(buffer.begin(), buffer.end(), 4U);
+
+    // Then
+    static_assert(std::is_same_v<collections::Counter<char>::storage_type,
+        collections::DenseStorage<char, std::hash<char>>>);
+    ASSERT_EQ(dense.size(), node.size());
+    ASSERT_EQ(dense.total(), node.total());
+    ASSERT_EQ(dense.mostCommon(), node.mostCommon());
+    ASSERT_EQ(dense.mostCommon(5), node.mostCommon(5));
+    ASSERT_EQ(std::ranges::distance(dense.elements()), std::ranges::distance(node.elements()));
+    ASSERT_EQ(dense.getUnderlyingMap(), node.getUnderlyingMap());
+    ASSERT_EQ(threaded.getUnderlyingMap(), dense.getUnderlyingMap());
+}
+
+TEST(DenseStorageTest, GivenCountNearIntMax_WhenAddingByteRange_ExpectOverflowErrorAndCountsUnchanged)
+{
+    // Given
+    const std::string bytes { "aab" };
+    collections::DenseStorage<char, std::hash<char>> storage {};
+    storage['a'] = std::numeric_limits<int>::max() - 1;
+
+    // When / Then
+    ASSERT_THROW(storage.addRange(bytes.begin(), bytes.end()), std::overflow_error);
+    ASSERT_EQ(storage['a'], std::numeric_limits<int>::max() - 1);
+    ASSERT_FALSE(storage.contains('b'));
+}
+
+TEST(DenseStorageTest, GivenEnumAndUnsignedKeys_WhenCounting_ExpectCountsPerKey)
+{
+    // Given
+    enum class Color : std::uint8_t { RED, GREEN, BLUE };
+    const std::vector<Color> colors { Color::RED, Color::BLUE, Color::BLUE, Color::RED, Color::BLUE };
+    const std::vector<std::uint8_t> bytes { 255U, 0U, 255U };
+
+    // When
+    collections::Counter<Color> color_counter(colors.begin(), colors.end());
+    collections::Counter<std::uint8_t> byte_counter(bytes.begin(), bytes.end());
+    collections::Counter<std::int16_t, std::hash<std::int16_t>, collections::DenseStorage> wide_counter {};
+    wide_counter[-300] += 2;
+
+    // Then
+    ASSERT_EQ(color_counter.mostCommon(1), (std::vector<std::pair<Color, int>> { { Color::BLUE, 3 } }));
+    ASSERT_EQ(color_counter[Color::GREEN], 0);
+    ASSERT_EQ(color_counter.size(), 3U);
+    using ByteItems = std::vector<std::pair<std::uint8_t, int>>;
+    ASSERT_EQ(byte_counter.mostCommon(), (ByteItems { { 255U, 2 }, { 0U, 1 } }));
+    ASSERT_EQ(wide_counter.mostCommon(), (std::vector<std::pair<std::int16_t, int>> { { -300, 2 } }));
+}
+
+TEST(DenseStorageTest, GivenBoolKeys_WhenCounting_ExpectNodeStorage)
+{
+    // Given
+    const std::vector<bool> flags { true, false, true, true };
+
+    // When
+    const collections::Counter<bool> counter(flags.begin(), flags.end());
+
+    // Then
+    static_assert(std::is_same_v<collections::Counter<bool>::storage_type,
+        collections::NodeStorage<bool, std::hash<bool>>>);
+    ASSERT_EQ(counter.mostCommon(), (std::vector<std::pair<bool, int>> { { true, 3 }, { false, 1 } }));
+}
+
+TEST(TupleHashTest, GivenPermutedOrDiagonalTuples_WhenHashing_ExpectDistinctHashes)
+{
+    // Given
+    const collections::TupleHash hash {};
+    std::unordered_set<std::size_t> pair_hashes {};
+    std::unordered_set<std::size_t> triple_hashes {};
+
+    // When
+    for (int x = -50; x < 50; ++x) {
+        for (int y = -50; y < 50; ++y) {
+            pair_hashes.insert(hash(std::make_pair(x, y)));
+            triple_hashes.insert(hash(std::make_tuple(x, y, std::string("z"))));
+        }
+    }
+
+    // Then
+    ASSERT_EQ(pair_hashes.size(), 100U * 100U);
+    ASSERT_EQ(triple_hashes.size(), 100U * 100U);
+    ASSERT_NE(hash(std::make_tuple(1, 2, 3)), hash(std::make_tuple(3, 2, 1)));
+    ASSERT_NE(hash(std::make_tuple(7, 7)), hash(std::make_tuple(8, 8)));
+    ASSERT_EQ(hash(std::make_pair(3, 4)), hash(std::make_tuple(3, 4)));
+    ASSERT_NE(hash(std::make_tuple(std::make_pair(1, 2), 3)), hash(std::make_tuple(std::make_pair(2, 1), 3)));
+    static_assert(collections::packPair(-1, 2) == 0xffffffff00000002ULL);
+}
+
+TEST(FlatMapTest, GivenManyInsertions_WhenGrowing_ExpectSameContentsAsUnorderedMap)
+{
+    // Given
+    collections::FlatMap<int, int> flat {};
+    std::unordered_map<int, int> reference {};
+    std::mt19937 rng { 7U };
+    std::uniform_int_distribution<int> pick_key { -5000, 5000 };
+
+    // When
+    for (int i = 0; i < 50000; ++i) {
+        const auto key = pick_key(rng);
+        flat[key] += i;
+        reference[key] += i;
+    }
+
+    // Then
+    ASSERT_EQ(flat.size(), reference.size());
+    ASSERT_LE(flat.size() * 8U, flat.capacity() * 7U);
+    for (const auto& [key, value] : reference)
+        ASSERT_EQ(*flat.find(key), value);
+    for (const auto& [key, value] : flat)
+        ASSERT_EQ(reference.at(key), value);
+    ASSERT_EQ(flat.find(6000), nullptr);
+}
+
+TEST(GridTest, GivenLinesAndBorder_WhenReadingNeighborsByOffset_ExpectBorderOutsideTheGrid)
+{
+    // Given
+    const strings lines { "ab", "cd", "ef" };
+    const grid::Grid<char> grid(lines, '#');
+
+    // When
+    const auto corner = grid.index(0, 0);
+    std::string neighbors {};
+    for (const auto offset : grid.neighborOffsets())
+        neighbors += grid[corner + offset];
+
+    // Then
+    ASSERT_EQ(grid.rows(), 3);
+    ASSERT_EQ(grid.cols(), 2);
+    ASSERT_EQ(grid.stride(), 4);
+    ASSERT_EQ(neighbors, "#cb#");
+    ASSERT_EQ(grid(2, 1), 'f');
+    ASSERT_EQ((grid[grid::Location { 1, 0 }]), 'c');
+    ASSERT_EQ(grid.location(grid.index(2, 1)), (grid::Location { 2, 1 }));
+    ASSERT_EQ(std::string(grid.row(1).begin(), grid.row(1).end()), "cd");
+    ASSERT_FALSE(grid.inBounds(-1, 0));
+    ASSERT_FALSE(grid.inBounds(0, 2));
+    ASSERT_THROW(grid::Grid<char>(strings { "ab", "c" }), std::invalid_argument);
+}
+
+TEST(GridTest, GivenCopy_WhenModifyingIt_ExpectOriginalUnchanged)
+{
+    // Given
+    grid::Grid<int> grid(2, 3, 1, -1);
+
+    // When
+    auto copy = grid;
+    copy(1, 2) = 7;
+
+    // Then
+    ASSERT_EQ(grid(1, 2), 1);
+    ASSERT_EQ(copy(1, 2), 7);
+    ASSERT_EQ(copy(1, 3), -1);
+    ASSERT_EQ(copy.size(), 6U);
+}
+
+/// @brief Fixture class to facilitate parameterized tests of grids mapped from files
+class MappedGridFixture : public testing::TestWithParam<std::string> { };
+
+TEST_P(MappedGridFixture, GivenRectangularFile_WhenMapping_ExpectCellsViewedInPlace)
+{
+    // Given
+    const auto path = writeTempFile("mapped_grid.txt", GetParam());
+
+    // When
+    std::error_code ec {};
+    const auto grid = grid::loadGrid(path, ec);
+
+    // Then
+    ASSERT_FALSE(ec);
+    ASSERT_EQ(grid.rows(), 3);
+    ASSERT_EQ(grid.cols(), 4);
+    ASSERT_EQ(grid(0, 0), '.');
+    ASSERT_EQ(grid(1, 2), '#');
+    ASSERT_EQ(grid(2, 3), 'x');
+}
+
+INSTANTIATE_TEST_SUITE_P(MappedGridTests, MappedGridFixture,
+    testing::Values("....\n..#.\n...x", "....\n..#.\n...x\n\n", "....\r\n..#.\r\n...x\r\n"));
+
+TEST(MappedGridTest, GivenRaggedOrMissingFile_WhenMapping_ExpectErrorStatus)
+{
+    // Given
+    const auto ragged = writeTempFile("ragged_grid.txt", "....\n...\n.....\n");
+
+    // When
+    std::error_code ragged_ec {};
+    const auto ragged_grid = grid::loadGrid(ragged, ragged_ec);
+    std::error_code missing_ec {};
+    const auto missing_grid = grid::loadGrid("/nonexistent/grid.txt", missing_ec);
+
+    // Then
+    ASSERT_EQ(ragged_ec, std::errc::invalid_argument);
+    ASSERT_TRUE(ragged_grid.empty());
+    ASSERT_EQ(missing_ec, std::errc::no_such_file_or_directory);
+    ASSERT_TRUE(missing_grid.empty());
+}
+
+/// @brief Random grid of '.' and '#' cells
+strings randomMaze(int rows, int cols, double wall_ratio, unsigned seed)
+{
+    std::mt19937 rng { seed };
+    std::bernoulli_distribution is_wall { wall_ratio };
+    strings maze(static_cast<std::size_t>(rows), std::string(static_cast<std::size_t>(cols), '.'));
+    for (auto& line : maze)
+        for (auto& cell : line)
+            cell = is_wall(rng) ? '#' : '.';
+    return maze;
+}
+
+/// @brief Fixture class to facilitate parameterized tests of GridSearch, with or without border
+class GridSearchFixture : public testing::TestWithParam<std::tuple<SearchMode, bool>> { };
+
+TEST_P(GridSearchFixture, GivenRandomMaze_WhenSearchingEveryCell_ExpectSameComponentsAsDfs)
+{
+    // Given
+    const auto maze = randomMaze(40, 50, 0.4, 11U);
+    const auto [mode, bordered] = GetParam();
+    const grid::Grid<char> grid(maze, bordered ? std::optional<char> { '.' } : std::nullopt);
+    const auto is_open = [](char cell) { return cell == '.'; };
+
+    // When
+    std::unordered_set<grid::Location, collections::TupleHash> visited {};
+    algorithms::GridSearch<char> search(grid);
+    std::vector<std::vector<grid::Location>> expected {};
+    std::vector<std::vector<grid::Location>> result {};
+    for (int x = 0; x < grid.rows(); ++x) {
+        for (int y = 0; y < grid.cols(); ++y) {
+            auto component = algorithms::dfs(maze, { x, y }, is_open, visited);
+            std::sort(component.begin(), component.end());
+            expected.push_back(component);
+
+            std::vector<grid::Location> reached {};
+            const auto count = search.search({ x, y }, is_open, mode,
+                [&](const grid::Location& location, int) { reached.push_back(location); });
+            ASSERT_EQ(count, reached.size());
+            std::sort(reached.begin(), reached.end());
+            result.push_back(reached);
+        }
+    }
+
+    // Then
+    ASSERT_EQ(result, expected);
+    ASSERT_TRUE(search.isVisited({ 0, 0 }) == (maze[0][0] == '.'));
+}
+
+INSTANTIATE_TEST_SUITE_P(GridSearchTests, GridSearchFixture,
+    testing::Combine(testing::Values(SearchMode::DFS, SearchMode::BFS), testing::Bool()));
+
+TEST(GridSearchTest, GivenMaze_WhenBfs_ExpectShortestDistances)
+{
+    // Given
+    const strings maze { "..#....", ".##.##.", "...#...", ".#...#." };
+    const grid::Grid<char> grid(maze);
+    algorithms::GridSearch<char> search(grid);
+
+    // When
+    const auto reached = search.bfs({ 0, 0 }, [](char cell) { return cell == '.'; });
+
+    // Then
+    ASSERT_EQ(reached.size(), 20U);
+    ASSERT_EQ(reached.front(), (grid::Location { 0, 0 }));
+    ASSERT_EQ(search.distance({ 3, 4 }), 7);
+    ASSERT_EQ(search.distance({ 0, 3 }), 15);
+    ASSERT_EQ(search.distance({ 0, 2 }), -1);
+    for (std::size_t i = 1U; i < reached.size(); ++i)
+        ASSERT_LE(search.distance(reached[i - 1U]), search.distance(reached[i]));
+
+    search.reset();
+    ASSERT_FALSE(search.isVisited({ 0, 0 }));
+    ASSERT_EQ(search.distance({ 3, 4 }), -1);
+}
+
+/// @brief Fixture class to facilitate parameterized tests of labelComponents over thread counts
+class LabelComponentsFixture : public testing::TestWithParam<unsigned> { };
+
+TEST_P(LabelComponentsFixture, GivenRandomMaze_WhenLabeling_ExpectSameComponentsAsRepeatedDfs)
+{
+    // Given
+    const auto maze = randomMaze(150, 70, 0.45, 5U);
+    const grid::Grid<char> grid(maze);
+    const auto is_open = [](char cell) { return cell == '.'; };
+
+    // When
+    const auto result = algorithms::labelComponents(grid, is_open, GetParam());
+
+    // Then
+    std::unordered_set<grid::Location, collections::TupleHash> visited {};
+    std::size_t label { 0U };
+    for (int x = 0; x < grid.rows(); ++x) {
+        for (int y = 0; y < grid.cols(); ++y) {
+            if (!is_open(grid(x, y))) {
+                ASSERT_EQ(result.labels(x, y), -1);
+            }
+            const auto component = algorithms::dfs(maze, { x, y }, is_open, visited);
+            if (component.empty())
+                continue;
+            ASSERT_LT(label, result.sizes.size());
+            ASSERT_EQ(result.sizes[label], component.size());
+            for (const auto& location : component)
+                ASSERT_EQ(result.labels[location], static_cast<int>(label));
+            ++label;
+        }
+    }
+    ASSERT_EQ(result.sizes.size(), label);
+}
+
+INSTANTIATE_TEST_SUITE_P(LabelComponentsTests, LabelComponentsFixture, testing::Values(1U, 2U, 3U, 8U));
+
+TEST(RadixHeapTest, GivenMonotonePushes_WhenPopping_ExpectSameOrderAsPriorityQueue)
+{
+    // Given
+    collections::RadixHeap<int> heap {};
+    std::priority_queue<std::uint32_t, std::vector<std::uint32_t>, std::greater<>> reference {};
+    std::mt19937 rng { 17U };
+    std::uniform_int_distribution<std::uint32_t> pick_step { 0U, 100U };
+
+    // When
+    std::uint32_t last { 0U };
+    for (int i = 0; i < 20000; ++i) {
+        if (i % 3 == 2) {
+            ASSERT_EQ(heap.topKey(), reference.top());
+            last = heap.pop().first;
+            ASSERT_EQ(last, reference.top());
+            reference.pop();
+        } else {
+            const auto key = last + pick_step(rng);
+            heap.push(key, i);
+            reference.push(key);
+        }
+    }
+
+    // Then
+    ASSERT_EQ(heap.size(), reference.size());
+    ASSERT_THROW(heap.push(last - 1U, 0), std::invalid_argument);
+    while (!heap.empty()) {
+        ASSERT_EQ(heap.pop().first, reference.top());
+        reference.pop();
+    }
+    ASSERT_THROW(heap.pop(), std::out_of_range);
+}
+
+/// @brief Shortest distances from {0, 0} over a grid of digits, entering a cell costing its digit
+std::vector<std::vector<int>> referenceDijkstra(const strings& digits)
+{
+    const auto rows = static_cast<int>(digits.size());
+    const auto cols = static_cast<int>(digits[0].size());
+    std::vector<std::vector<int>> distances(rows, std::vector<int>(cols, std::numeric_limits<int>::max()));
+    std::priority_queue<std::pair<int, std::pair<int, int>>, std::vector<std::pair<int, std::pair<int, int>>>,
+        std::greater<>>
+        queue {};
+    distances[0][0] = 0;
+    queue.push({ 0, { 0, 0 } });
+    while (!queue.empty()) {
+        const auto [distance, location] = queue.top();
+        queue.pop();
+        if (distance > distances[location.first][location.second])
+            continue;
+        for (auto [dx, dy] : grid::move()) {
+            const auto nx = location.first + dx;
+            const auto ny = location.second + dy;
+            if (!grid::inBounds(digits, nx, ny))
+                continue;
+            const auto next = distance + (digits[nx][ny] - '0');
+            if (next < distances[nx][ny]) {
+                distances[nx][ny] = next;
+                queue.push({ next, { nx, ny } });
+            }
+        }
+    }
+    return distances;
+}
+
+/// @brief Fixture class to facilitate parameterized tests of GridPaths, with or without border
+class GridPathsFixture : public testing::TestWithParam<bool> { };
+
+TEST_P(GridPathsFixture, GivenWeightedGrid_WhenRunningDijkstraAndAStar_ExpectReferenceDistances)
+{
+    // Given
+    std::mt19937 rng { 23U };
+    std::uniform_int_distribution<int> pick_digit { 1, 9 };
+    strings digits(60, std::string(45, '1'));
+    for (auto& line : digits)
+        for (auto& cell : line)
+            cell = static_cast<char>('0' + pick_digit(rng));
+    const grid::Grid<char> grid(digits, GetParam() ? std::optional<char> { '#' } : std::nullopt);
+    const auto cost = [](const algorithms::GridState&, const algorithms::GridState&, char cell) {
+        return cell == '#' ? -1 : cell - '0';
+    };
+    const grid::Location goal { grid.rows() - 1, grid.cols() - 1 };
+    const auto is_goal = [&](const algorithms::GridState& state) { return state.location == goal; };
+    const auto manhattan = [&](const algorithms::GridState& state) {
+        return std::abs(goal.first - state.location.first) + std::abs(goal.second - state.location.second);
+    };
+    const auto expected = referenceDijkstra(digits);
+    algorithms::GridPaths<char> paths(grid);
+
+    // When
+    const auto everywhere = paths.run({ { 0, 0 } }, cost, [](const algorithms::GridState&) { return false; });
+    std::vector<std::vector<int>> distances(grid.rows(), std::vector<int>(grid.cols(), 0));
+    for (int x = 0; x < grid.rows(); ++x)
+        for (int y = 0; y < grid.cols(); ++y)
+            distances[x][y] = paths.distance({ { x, y } });
+    const auto dijkstra = paths.run({ { 0, 0 } }, cost, is_goal);
+    const auto a_star = paths.run({ { 0, 0 } }, cost, is_goal, manhattan);
+    const auto path = paths.path({ goal });
+
+    // Then
+    ASSERT_EQ(everywhere, -1);
+    ASSERT_EQ(distances, expected);
+    ASSERT_EQ(dijkstra, expected[goal.first][goal.second]);
+    ASSERT_EQ(a_star, dijkstra);
+    ASSERT_EQ(path.front().location, (grid::Location { 0, 0 }));
+    ASSERT_EQ(path.back().location, goal);
+    int path_cost { 0 };
+    for (std::size_t i = 1U; i < path.size(); ++i)
+        path_cost += grid[path[i].location] - '0';
+    ASSERT_EQ(path_cost, a_star);
+}
+
+INSTANTIATE_TEST_SUITE_P(GridPathsTests, GridPathsFixture, testing::Bool());
+
+TEST(GridPathsTest, GivenBorderNotBlockedByCost_WhenRunning_ExpectMovesStayInsideGrid)
+{
+    // Given
+    const strings open { "...", "...", "..." };
+    const grid::Grid<char> grid(open, '#');
+    int border_moves { 0 };
+    const auto cost = [&](const algorithms::GridState&, const algorithms::GridState& to, char cell) {
+        border_moves += cell == '#' || !grid.inBounds(to.location);
+        return 1;
+    };
+    algorithms::GridPaths<char> paths(grid, true);
+
+    // When
+    const auto distance = paths.run({ { 1, 1 } }, cost, [](const algorithms::GridState&) { return false; });
+
+    // Then
+    ASSERT_EQ(distance, -1);
+    ASSERT_EQ(border_moves, 0);
+    ASSERT_EQ(paths.distance({ { 0, 0 }, grid::Direction::UP }), 2);
+    ASSERT_EQ(paths.distance({ { 0, 0 }, grid::Direction::DOWN }), -1);
+    ASSERT_EQ(paths.distance({ { 2, 2 }, grid::Direction::DOWN }), 2);
+    ASSERT_EQ(paths.distance({ { 2, 2 }, grid::Direction::UP }), -1);
+}
+
+TEST(GridPathsTest, GivenTurnCost_WhenRunningDirectionalSearch_ExpectFewestTurns)
+{
+    // Given
+    const strings maze { "....", ".#..", "....", "...." };
+    const grid::Grid<char> grid(maze);
+    const auto cost = [](const algorithms::GridState& from, const algorithms::GridState& to, char cell) {
+        if (cell == '#')
+            return -1;
+        return from.direction == to.direction ? 1 : 1001;
+    };
+    algorithms::GridPaths<char> paths(grid, true);
+    const algorithms::GridState start { { 0, 0 }, grid::Direction::LEFT };
+
+    // When
+    const auto is_goal
+        = [](const algorithms::GridState& state) { return state.location == grid::Location { 3, 3 }; };
+    const auto distance = paths.run(start, cost, is_goal);
+    const auto path = paths.path({ { 3, 3 }, grid::Direction::DOWN });
+
+    // Then
+    ASSERT_EQ(distance, 1006);
+    ASSERT_EQ(path.size(), 7U);
+    ASSERT_EQ(path[3], (algorithms::GridState { { 0, 3 }, grid::Direction::LEFT }));
+    ASSERT_EQ(path.back(), (algorithms::GridState { { 3, 3 }, grid::Direction::DOWN }));
+    ASSERT_EQ(paths.distance({ { 3, 3 }, grid::Direction::LEFT }), -1);
+}
+
+/// @brief Search state of a maze with keys: a location and the bitmask of collected keys
+struct KeyState {
+    int x { 0 };
+    int y { 0 };
+    std::uint32_t keys { 0U };
+
+    bool operator==(const KeyState& other) const = default;
+};
+
+/// @brief Pack a KeyState into 16 bits of x, 16 bits of y and 26 bits of keys
+struct KeyStateCodec {
+    using key_type = std::uint64_t;
+
+    static std::uint64_t encode(const KeyState& state)
+    {
+        return (static_cast<std::uint64_t>(state.x) << 48U) | (static_cast<std::uint64_t>(state.y) << 32U)
+            | state.keys;
+    }
+
+    static KeyState decode(std::uint64_t key)
+    {
+        return { static_cast<int>(key >> 48U), static_cast<int>((key >> 32U) & 0xffffU),
+            static_cast<std::uint32_t>(key & 0xffffffffU) };
+    }
+};
+
+TEST(StateSearchTest, GivenMazeWithKeysAndDoors_WhenBfsOverPackedStates_ExpectShortestPath)
+{
+    // Given
+    const strings maze { "#########", "#b.A@.a.#", "#########" };
+    const auto neighbors = [&](const KeyState& state, auto&& emit) {
+        for (auto [dx, dy] : grid::move()) {
+            auto next = KeyState { state.x + dx, state.y + dy, state.keys };
+            const auto cell = maze[next.x][next.y];
+            if (cell == '#' || (std::isupper(cell) && !(next.keys & (1U << (cell - 'A')))))
+                continue;
+            if (std::islower(cell))
+                next.keys |= 1U << (cell - 'a');
+            emit(next);
+        }
+    };
+    const auto all_keys = [](const KeyState& state) { return state.keys == 3U; };
+    algorithms::StateSearch<KeyState, KeyStateCodec> search {};
+
+    // When
+    const auto steps = search.bfs(KeyState { 1, 4, 0U }, neighbors, all_keys);
+
+    // Then
+    ASSERT_EQ(steps, 7);
+    const auto path = search.path(KeyState { 1, 1, 3U });
+    ASSERT_EQ(path.size(), 8U);
+    ASSERT_EQ(path.front(), (KeyState { 1, 4, 0U }));
+    ASSERT_EQ(path[2], (KeyState { 1, 6, 1U }));
+    ASSERT_EQ(search.distance(KeyState { 1, 3, 1U }), 5);
+    ASSERT_EQ(search.distance(KeyState { 1, 3, 0U }), -1);
+    const auto impossible = [](const KeyState& state) { return state.keys == 4U; };
+    ASSERT_EQ(search.bfs(KeyState { 1, 4, 0U }, neighbors, impossible), -1);
+}
+
+TEST(StateSearchTest, GivenTurnCostGrid_WhenDijkstraOverTupleStates_ExpectSameDistanceAsGridPaths)
+{
+    // Given
+    std::mt19937 rng { 31U };
+    std::uniform_int_distribution<int> pick_digit { 1, 9 };
+    strings digits(30, std::string(40, '1'));
+    for (auto& line : digits)
+        for (auto& cell : line)
+            cell = static_cast<char>('0' + pick_digit(rng));
+    const grid::Grid<char> grid(digits);
+    const auto turn_cost = [](grid::Direction from, grid::Direction to) { return from == to ? 0 : 5; };
+    using State = std::tuple<int, int, grid::Direction>;
+    const auto neighbors = [&](const State& state, auto&& emit) {
+        const auto [x, y, direction] = state;
+        for (const auto& [step, next_direction] : grid::moveWithDIR())
+            if (grid.inBounds(x + step.first, y + step.second))
+                emit(State { x + step.first, y + step.second, next_direction },
+                    static_cast<std::uint32_t>(grid(x + step.first, y + step.second) - '0'
+                        + turn_cost(direction, next_direction)));
+    };
+    const auto at_goal = [&](const State& state) {
+        return std::get<0>(state) == grid.rows() - 1 && std::get<1>(state) == grid.cols() - 1;
+    };
+    algorithms::GridPaths<char> paths(grid, true);
+    algorithms::StateSearch<State> search {};
+
+    // When
+    const auto expected = paths.run(
+        algorithms::GridState { { 0, 0 }, grid::Direction::DOWN },
+        [&](const algorithms::GridState& from, const algorithms::GridState& to, char cell) {
+            return cell - '0' + turn_cost(from.direction, to.direction);
+        },
+        [&](const algorithms::GridState& state) {
+            return at_goal({ state.location.first, state.location.second, state.direction });
+        });
+    const auto distance = search.dijkstra(State { 0, 0, grid::Direction::DOWN }, neighbors, at_goal);
+
+    // Then
+    ASSERT_GT(distance, 0);
+    ASSERT_EQ(distance, expected);
+}
+
+TEST(StateSearchTest, GivenRandomMaze_WhenBidirectionalBfs_ExpectSameDistanceAsBfsAndValidPath)
+{
+    // Given
+    const auto maze = randomMaze(60, 60, 0.3, 2U);
+    using State = grid::Location;
+    const auto neighbors = [&](const State& state, auto&& emit) {
+        for (auto [dx, dy] : grid::move()) {
+            const State next { state.first + dx, state.second + dy };
+            if (grid::inBounds(maze, next.first, next.second) && maze[next.first][next.second] == '.')
+                emit(next);
+        }
+    };
+    algorithms::StateSearch<State> search {};
+
+    for (const auto& goal : { State { 59, 59 }, State { 30, 1 }, State { 0, 1 } }) {
+        if (maze[goal.first][goal.second] != '.')
+            continue;
+
+        // When
+        const State start { 0, 0 };
+        const auto expected = search.bfs(start, neighbors, [&](const State& state) { return state == goal; });
+        const auto distance = search.bidirectionalBfs(start, goal, neighbors);
+        const auto path = search.path(goal);
+
+        // Then
+        ASSERT_EQ(distance, expected);
+        if (distance < 0)
+            continue;
+        ASSERT_EQ(path.size(), static_cast<std::size_t>(distance) + 1U);
+        ASSERT_EQ(path.front(), start);
+        ASSERT_EQ(path.back(), goal);
+        for (std::size_t i = 1U; i < path.size(); ++i) {
+            const auto dx = std::abs(path[i].first - path[i - 1U].first);
+            const auto dy = std::abs(path[i].second - path[i - 1U].second);
+            ASSERT_EQ(dx + dy, 1);
+        }
+    }
+}
+
+TEST(SimulateTest, GivenCyclicStep_WhenSimulatingManySteps_ExpectExtrapolatedState)
+{
+    // Given
+    const auto step = [](std::uint64_t x) { return (x * x + 1U) % 100003U; };
+    std::uint64_t brute_force { 7U };
+    for (int i = 0; i < 50000; ++i)
+        brute_force = step(brute_force);
+
+    // When
+    const auto short_run = algorithms::simulate(std::uint64_t { 7U }, step, 50000U);
+    const auto long_run = algorithms::simulate(std::uint64_t { 7U }, step, 1'000'000'000'000U);
+    const auto equivalent = algorithms::simulate(std::uint64_t { 7U }, step,
+        long_run.cycle_start + (1'000'000'000'000U - long_run.cycle_start) % long_run.period);
+
+    // Then
+    ASSERT_EQ(short_run.state, brute_force);
+    ASSERT_GT(long_run.period, 0U);
+    ASSERT_EQ(long_run.state, equivalent.state);
+}
+
+TEST(ZipTest, GivenRangesOfDifferentLengths_WhenZipping_ExpectReferencesUpToTheShortest)
+{
+    // Given
+    std::vector<int> numbers { 1, 2, 3, 4 };
+    const std::string_view letters { "abc" };
+    const double weights[] { 0.5, 1.5, 2.5, 3.5, 4.5 };
+
+    // When
+    auto zipped = pypp::zip(numbers, letters, std::span(weights, 5U));
+    std::vector<std::tuple<int, char, double>> result {};
+    for (auto [number, letter, weight] : zipped) {
+        result.emplace_back(number, letter, weight);
+        number *= 10;
+    }
+
+    // Then
+    static_assert(std::ranges::forward_range<decltype(zipped)>);
+    static_assert(std::ranges::borrowed_range<decltype(pypp::zip(letters, std::span(weights, 5U)))>);
+    ASSERT_EQ(zipped.size(), 3U);
+    using Rows = std::vector<std::tuple<int, char, double>>;
+    ASSERT_EQ(result, (Rows { { 1, 'a', 0.5 }, { 2, 'b', 1.5 }, { 3, 'c', 2.5 } }));
+    ASSERT_EQ(numbers, (std::vector<int> { 10, 20, 30, 4 }));
+}
+
+TEST(ZipTest, GivenLazyViews_WhenZipping_ExpectComposableRange)
+{
+    // Given
+    const std::vector<std::string> keys { "x", "y", "z" };
+    auto squares = std::views::iota(1) | std::views::transform([](int i) { return i * i; });
+
+    // When
+    std::vector<std::pair<std::string, int>> result {};
+    for (const auto& [key, square] : pypp::zip(keys, squares) | std::views::drop(1))
+        result.emplace_back(key, square);
+
+    // Then
+    ASSERT_EQ(result, (std::vector<std::pair<std::string, int>> { { "y", 4 }, { "z", 9 } }));
+}
+
+TEST(ZipTest, GivenPointers_WhenZippingIterators_ExpectMaterializedTuples)
+{
+    // Given
+    const int numbers[] { 1, 2, 3 };
+    const char letters[] { 'a', 'b', 'c' };
+
+    // When
+    const auto result = pypp::zip(numbers, numbers + 3, letters);
+
+    // Then
+    ASSERT_EQ(result, (std::vector<std::tuple<int, char>> { { 1, 'a' }, { 2, 'b' }, { 3, 'c' } }));
+}
+
+TEST(ZipTest, GivenCArrays_WhenZipping_ExpectLazyZipOverWholeArrays)
+{
+    // Given
+    int numbers[] { 1, 2, 3 };
+    const char letters[] { 'a', 'b', 'c' };
+    const double weights[] { 0.5, 1.5 };
+
+    // When
+    const auto pairs = pypp::zip(numbers, letters);
+    const auto triples = pypp::zip(numbers, letters, weights);
+    const auto single = pypp::zip(letters, letters + 2);
+    for (auto&& [number, letter] : pairs)
+        number *= 10;
+
+    // Then
+    ASSERT_EQ(std::ranges::distance(pairs), 3);
+    ASSERT_EQ(std::ranges::distance(triples), 2);
+    ASSERT_EQ(std::get<2>(*std::ranges::next(triples.begin())), 1.5);
+    ASSERT_EQ(numbers[2], 30);
+    ASSERT_EQ(single, (std::vector<std::tuple<char>> { { 'a' }, { 'b' } }));
+}
+
+TEST(ItertoolsTest, GivenRanges_WhenProduct_ExpectNestedLoopOrderAndSeekableTuples)
+{
+    // Given
+    const std::vector<int> numbers { 1, 2, 3 };
+    const std::string_view letters { "ab" };
+    const std::vector<bool> flags { false, true };
+
+    // When
+    const auto product = itertools::product(numbers, letters, flags);
+    std::vector<std::tuple<int, char, bool>> result {};
+    for (const auto& [number, letter, flag] : product)
+        result.emplace_back(number, letter, flag);
+
+    // Then
+    std::vector<std::tuple<int, char, bool>> expected {};
+    for (const auto number : numbers)
+        for (const auto letter : letters)
+            for (const bool flag : flags)
+                expected.emplace_back(number, letter, flag);
+    ASSERT_EQ(product.size(), 12U);
+    ASSERT_EQ(result, expected);
+    for (std::size_t i = 0U; i < expected.size(); ++i)
+        ASSERT_EQ((std::tuple<int, char, bool>(*product.iteratorAt(i))), expected[i]);
+    ASSERT_TRUE(itertools::product(numbers, std::string_view {}).empty());
+}
+
+TEST(ItertoolsTest, GivenRange_WhenCombinationsAndPermutations_ExpectLexicographicIndexTuples)
+{
+    // Given
+    const std::vector<int> numbers { 0, 1, 2, 3, 4, 5, 6 };
+
+    // When
+    const auto combinations = itertools::combinations<3>(numbers);
+    const auto permutations = itertools::permutations<3>(numbers);
+    std::vector<std::tuple<int, int, int>> combined(combinations.begin(), combinations.end());
+    std::vector<std::tuple<int, int, int>> permuted(permutations.begin(), permutations.end());
+
+    // Then
+    std::vector<std::tuple<int, int, int>> expected_combinations {};
+    std::vector<std::tuple<int, int, int>> expected_permutations {};
+    for (int a = 0; a < 7; ++a) {
+        for (int b = 0; b < 7; ++b) {
+            for (int c = 0; c < 7; ++c) {
+                if (a < b && b < c)
+                    expected_combinations.emplace_back(a, b, c);
+                if (a != b && b != c && a != c)
+                    expected_permutations.emplace_back(a, b, c);
+            }
+        }
+    }
+    ASSERT_EQ(combinations.size(), 35U);
+    ASSERT_EQ(combined, expected_combinations);
+    ASSERT_EQ(permutations.size(), 210U);
+    ASSERT_EQ(permuted, expected_permutations);
+    for (std::size_t i = 0U; i < expected_combinations.size(); ++i)
+        ASSERT_EQ((std::tuple<int, int, int>(*combinations.iteratorAt(i))), expected_combinations[i]);
+    for (std::size_t i = 0U; i < expected_permutations.size(); ++i)
+        ASSERT_EQ((std::tuple<int, int, int>(*permutations.iteratorAt(i))), expected_permutations[i]);
+    ASSERT_EQ(itertools::combinations<4>(std::vector<int>(5000)).size(), 26'010'428'123'750U);
+    ASSERT_TRUE(itertools::combinations<8>(numbers).empty());
+}
+
+TEST(ItertoolsTest, GivenRange_WhenWindowingChunkingAndAccumulating_ExpectPythonResults)
+{
+    // Given
+    const std::vector<int> numbers { 3, 1, 4, 1, 5 };
+
+    // When
+    std::vector<std::pair<int, int>> pairs {};
+    for (const auto& [a, b] : itertools::pairwise(numbers))
+        pairs.emplace_back(a, b);
+    std::vector<std::vector<int>> windows {};
+    for (const auto window : itertools::slidingWindow(numbers, 3U))
+        windows.emplace_back(window.begin(), window.end());
+    std::vector<std::vector<int>> chunks {};
+    for (const auto chunk : itertools::chunked(numbers, 2U))
+        chunks.emplace_back(chunk.begin(), chunk.end());
+    const auto totals = itertools::accumulate(numbers);
+    std::vector<int> running_max {};
+    std::ranges::copy(itertools::accumulate(numbers, [](int a, int b) { return std::max(a, b); }),
+        std::back_inserter(running_max));
+    std::vector<int> deltas {};
+    for (const auto& [total, pair] : pypp::zip(totals, itertools::pairwise(numbers)))
+        deltas.push_back(total + std::get<1>(pair) - std::get<0>(pair));
+
+    // Then
+    ASSERT_EQ(pairs, (std::vector<std::pair<int, int>> { { 3, 1 }, { 1, 4 }, { 4, 1 }, { 1, 5 } }));
+    ASSERT_EQ(windows, (std::vector<std::vector<int>> { { 3, 1, 4 }, { 1, 4, 1 }, { 4, 1, 5 } }));
+    ASSERT_EQ(chunks, (std::vector<std::vector<int>> { { 3, 1 }, { 4, 1 }, { 5 } }));
+    ASSERT_TRUE(std::ranges::equal(totals, std::vector<int> { 3, 4, 8, 9, 14 }));
+    ASSERT_EQ(running_max, (std::vector<int> { 3, 3, 4, 4, 5 }));
+    ASSERT_EQ(deltas, (std::vector<int> { 1, 7, 5, 13 }));
+    ASSERT_TRUE(itertools::slidingWindow(numbers, 6U).empty());
+    ASSERT_THROW(itertools::chunked(numbers, 0U), std::invalid_argument);
+}
+
+TEST(ItertoolsTest, GivenCombinationSpace_WhenParallelForEach_ExpectEveryElementVisitedOnce)
+{
+    // Given
+    std::vector<int> numbers(60);
+    std::iota(numbers.begin(), numbers.end(), 1);
+    const auto triples = itertools::combinations<3>(numbers);
+    std::int64_t expected { 0 };
+    for (const auto& [a, b, c] : triples)
+        expected += a * b * c;
+
+    // When
+    std::atomic<std::int64_t> total { 0 };
+    std::atomic<std::size_t> count { 0U };
+    itertools::parallelForEach(
+        triples,
+        [&](const auto& triple) {
+            const auto& [a, b, c] = triple;
+            total += a * b * c;
+            ++count;
+        },
+        4U);
+
+    // Then
+    ASSERT_EQ(count, triples.size());
+    ASSERT_EQ(total, expected);
+    std::size_t partitioned { 0U };
+    for (std::size_t part = 0U; part < 7U; ++part)
+        partitioned += std::ranges::distance(itertools::partition(triples, part, 7U));
+    ASSERT_EQ(partitioned, triples.size());
+}
+
+using LongLongs = std::vector<long long>;
+
+/// @brief Fixture class to facilitate parameterized tests of extractInts
+class ExtractIntsFixture : public testing::TestWithParam<std::tuple<std::string, LongLongs>> { };
+
+TEST_P(ExtractIntsFixture, GivenText_WhenExtractingInts_ExpectSignedRunsOfDigits)
+{
+    // Given
+    const auto text = std::get<0>(GetParam());
+    const auto expected = std::get<1>(GetParam());
+
+    // When
+    const auto result = pypp::extractInts<long long>(text);
+
+    // Then
+    ASSERT_EQ(result, expected);
+}
+
+INSTANTIATE_TEST_SUITE_P(ExtractIntsTests, ExtractIntsFixture,
+    testing::Values(std::make_tuple("move 3 from 5 to 7", LongLongs { 3, 5, 7 }),
+        std::make_tuple("x=12, y=-4", LongLongs { 12, -4 }),
+        std::make_tuple("1-3 +8 --5", LongLongs { 1, -3, 8, -5 }),
+        std::make_tuple("no digits here, not even in a long line of text - at all", LongLongs {}),
+        std::make_tuple("padding to cross vector blocks .. 9223372036854775807, -9223372036854775808 ... 42",
+            LongLongs { 9223372036854775807LL, -9223372036854775807LL - 1, 42 }),
+        std::make_tuple("", LongLongs {})));
+
+TEST(ExtractIntsTest, GivenUnsignedTypeOrSmallBuffer_WhenExtractingInts_ExpectRangesAndTruncation)
+{
+    // Given
+    const std::string_view ranges { "2-4,6-8" };
+    std::array<int, 3U> buffer {};
+
+    // When
+    const auto bounds = pypp::extractInts<unsigned>(ranges);
+    const auto written = pypp::extractInts<int>("10 20 30 40 50", std::span(buffer));
+
+    // Then
+    ASSERT_EQ(bounds, (std::vector<unsigned> { 2U, 4U, 6U, 8U }));
+    ASSERT_EQ(written, 3U);
+    ASSERT_EQ(buffer, (std::array<int, 3U> { 10, 20, 30 }));
+    ASSERT_THROW(pypp::extractInts<std::int8_t>("127 128"), std::out_of_range);
+}
+
+TEST(ParseIntsTest, GivenBuffer_WhenParsingInts_ExpectOneRowPerLine)
+{
+    // Given
+    const std::string_view buffer { "p=0,4 v=3,-3\n\nno numbers\n-1 -2 -3\n" };
+
+    // When
+    const auto rows = pypp::parseInts(buffer);
+    const auto with_blank = pypp::parseInts<std::int64_t>(buffer, { false, true });
+
+    // Then
+    ASSERT_EQ(rows.size(), 3U);
+    ASSERT_TRUE(std::ranges::equal(rows[0], std::vector<int> { 0, 4, 3, -3 }));
+    ASSERT_TRUE(rows[1].empty());
+    ASSERT_TRUE(std::ranges::equal(rows[2], std::vector<int> { -1, -2, -3 }));
+    ASSERT_EQ(with_blank.size(), 4U);
+    ASSERT_EQ(with_blank.values.size(), 7U);
+}
+
+TEST(ScanTest, GivenMatchingLines_WhenScanning_ExpectTypedFields)
+{
+    // Given
+    const std::string_view move { "move 3 from 5 to 7" };
+    const std::string_view edge { "AAA = (BBB, -1.5) x" };
+
+    // When
+    const auto moved = pypp::scan<"move {} from {} to {}", int, int, int>(move);
+    const auto parsed = pypp::scan<"{} = ({}, {}) {}", std::string_view, std::string, double, char>(edge);
+    const auto literal = pypp::scan<"no fields">("no fields");
+
+    // Then
+    ASSERT_TRUE(moved.has_value());
+    ASSERT_EQ(*moved, std::make_tuple(3, 5, 7));
+    ASSERT_TRUE(parsed.has_value());
+    ASSERT_EQ(std::get<0>(*parsed), "AAA");
+    ASSERT_EQ(std::get<1>(*parsed), "BBB");
+    ASSERT_EQ(std::get<2>(*parsed), -1.5);
+    ASSERT_EQ(std::get<3>(*parsed), 'x');
+    ASSERT_EQ(std::get<0>(*parsed).data(), edge.data());
+    ASSERT_TRUE(literal.has_value());
+}
+
+TEST(ScanTest, GivenMismatchingLines_WhenScanning_ExpectNoValue)
+{
+    // Given / When / Then
+    ASSERT_FALSE((pypp::scan<"move {} from {} to {}", int, int, int>("move 3 from 5 to")));
+    ASSERT_FALSE((pypp::scan<"move {} from {} to {}", int, int, int>("move 3 from 5 to 7 ")));
+    ASSERT_FALSE((pypp::scan<"move {} from {} to {}", int, int, int>("move x from 5 to 7")));
+    ASSERT_FALSE((pypp::scan<"move {} from {} to {}", int, int, int>("Move 3 from 5 to 7")));
+    ASSERT_FALSE((pypp::scan<"{}: {}", std::int8_t, unsigned>("128: 1")));
+    ASSERT_FALSE((pypp::scan<"{}: {}", std::int8_t, unsigned>("1: -1")));
+    ASSERT_FALSE((pypp::scan<"{} -> {}", std::string_view, std::string_view>("a => b")));
+    ASSERT_FALSE((pypp::scan<"{}", char>("")));
+}
+
+TEST(ScanTest, GivenFile_WhenScanningLines_ExpectColumnsAndMismatches)
+{
+    // Given
+    const std::string contents { "move 1 from 2 to 3\nmove 4 from x to 6\n\nmove 10 from 20 to 30\n" };
+    const auto path = writeTempFile("scan_lines.txt", contents);
+    const pypp::MappedFile file(path);
+
+    // When
+    const auto result = pypp::scanLines<"move {} from {} to {}", int, std::uint8_t, long>(file.view());
+
+    // Then
+    ASSERT_EQ(result.size(), 2U);
+    ASSERT_EQ(result.column<0>(), (std::vector<int> { 1, 10 }));
+    ASSERT_EQ(result.column<1>(), (std::vector<std::uint8_t> { 2U, 20U }));
+    ASSERT_EQ(result.column<2>(), (std::vector<long> { 3, 30 }));
+    ASSERT_EQ(result.mismatches, (std::vector<std::size_t> { 1U }));
+}
+
+TEST(ArenaTest, GivenAllocations_WhenResetting_ExpectAlignedBumpAllocationAndReuse)
+{
+    // Given
+    pypp::Arena arena(256U);
+
+    // When
+    auto* const first = arena.allocate(3U, 1U);
+    auto* const aligned = arena.allocate(64U, 32U);
+    auto* const large = arena.allocate(1000U, 8U);
+    const auto capacity = arena.capacity();
+    arena.reset();
+    auto* const reused = arena.allocate(8U, 8U);
+
+    // Then
+    ASSERT_NE(first, aligned);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(aligned) % 32U, 0U);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(large) % 8U, 0U);
+    ASSERT_GE(capacity, 1067U);
+    ASSERT_LE(arena.capacity(), capacity);
+    ASSERT_GE(arena.capacity(), 1000U);
+    ASSERT_EQ(arena.used(), 8U);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(reused) % 8U, 0U);
+    arena.release();
+    ASSERT_EQ(arena.capacity(), 0U);
+}
+
+TEST(ArenaTest, GivenArena_WhenSplitting_ExpectSameTokensAllocatedFromArena)
+{
+    // Given
+    const std::string text { "a long enough first token to avoid small strings,b\nc,,d\n" };
+    pypp::Arena arena {};
+
+    // When
+    const auto tokens = pypp::split(text, ",\n", arena);
+    const auto first_two = pypp::split(text, ",\n", arena, 2);
+    const auto lines = pypp::splitLines(text, arena);
+    const auto views = pypp::splitLinesView(text, arena);
+    const auto ints = pypp::extractInts<int>("1, 2, 3", arena);
+    const auto pairs = pypp::zip(arena, views.begin(), views.end(), ints.begin());
+
+    // Then
+    ASSERT_TRUE(std::ranges::equal(tokens, pypp::split(text, ",\n"), std::equal_to<std::string_view> {}));
+    ASSERT_EQ(first_two.size(), 2U);
+    ASSERT_TRUE(std::ranges::equal(lines, pypp::splitLines(text), std::equal_to<std::string_view> {}));
+    ASSERT_TRUE(std::ranges::equal(views, pypp::splitLinesView(text)));
+    ASSERT_EQ(ints, (std::pmr::vector<int> { 1, 2, 3 }));
+    ASSERT_EQ(pairs.size(), 2U);
+    ASSERT_EQ(pairs[1], std::make_tuple(std::string_view { "c,,d" }, 2));
+    ASSERT_EQ(tokens.get_allocator().resource(), &arena);
+    ASSERT_EQ(tokens.front().get_allocator().resource(), &arena);
+    ASSERT_EQ(pairs.get_allocator().resource(), &arena);
+    ASSERT_GE(arena.used(), tokens.front().size());
+}
+
+TEST(ArenaTest, GivenFile_WhenSplittingFileLinesIntoArena_ExpectSameResultAsDefault)
+{
+    // Given
+    const auto path = writeTempFile("arena_lines.txt", "111\n\n222\r\n333");
+    pypp::Arena arena {};
+    std::error_code ec {};
+
+    // When
+    const auto lines = pypp::splitFileLines(path, ec, arena);
+
+    // Then
+    ASSERT_FALSE(ec);
+    ASSERT_TRUE(std::ranges::equal(lines, pypp::splitFileLines(path), std::equal_to<std::string_view> {}));
+    ASSERT_EQ(lines.get_allocator().resource(), &arena);
+}
+
+TEST(ArenaTest, GivenLiteralZero_WhenSplitting_ExpectAtMostInsteadOfResource)
+{
+    // Given
+    const std::string text { "a,b,c" };
+
+    // When
+    const auto tokens = pypp::split(text, ',', 0);
+
+    // Then
+    ASSERT_EQ(tokens, pypp::split(text, ',', 0));
+    ASSERT_TRUE((std::same_as<decltype(tokens), const strings>));
+}
+
+TEST(ArenaTest, GivenArena_WhenParsingLines_ExpectSameResultsAllocatedFromArena)
+{
+    // Given
+    const std::string text { "1 2\nx\n3,-4,5\nmove 1 from 2\n" };
+    pypp::Arena arena {};
+    const std::string words { "abacab" };
+    const collections::Counter<char> counter(words.begin(), words.end());
+
+    // When
+    const auto rows = pypp::parseInts(text, arena);
+    const auto moves = pypp::scanLines<"move {} from {}", int, int>(text, arena);
+    const auto lines = pypp::parallelSplitLines(text, arena, {}, { .chunk_size = 4U, .threads = 2U });
+    const auto common = counter.mostCommon(arena, 2);
+
+    // Then
+    const auto expected_rows = pypp::parseInts(text);
+    ASSERT_EQ(rows.size(), expected_rows.size());
+    for (std::size_t i = 0U; i < rows.size(); ++i)
+        ASSERT_TRUE(std::ranges::equal(rows[i], expected_rows[i]));
+    ASSERT_EQ(moves.column<0>(), (std::pmr::vector<int> { 1 }));
+    ASSERT_EQ(moves.column<1>(), (std::pmr::vector<int> { 2 }));
+    ASSERT_EQ(moves.mismatches, (std::pmr::vector<std::size_t> { 0U, 1U, 2U }));
+    ASSERT_TRUE(std::ranges::equal(lines, pypp::parallelSplitLines(text)));
+    ASSERT_TRUE(std::ranges::equal(common, counter.mostCommon(2)));
+    ASSERT_EQ(rows.values.get_allocator().resource(), &arena);
+    ASSERT_EQ(rows.offsets.get_allocator().resource(), &arena);
+    ASSERT_EQ(moves.column<0>().get_allocator().resource(), &arena);
+    ASSERT_EQ(moves.mismatches.get_allocator().resource(), &arena);
+    ASSERT_EQ(lines.get_allocator().resource(), &arena);
+    ASSERT_EQ(common.get_allocator().resource(), &arena);
+}
+
+TEST(InternerTest, GivenStrings_WhenInterning_ExpectDenseIdsAndReverseLookup)
+{
+    // Given
+    pypp::Interner interner {};
+
+    // When
+    const auto a = interner.intern("alpha");
+    const auto b = interner.intern("beta");
+    const auto again = interner.intern(std::string("alpha"));
+    const auto empty = interner.intern("");
+    std::vector<pypp::Interner::id_type> many {};
+    for (int i = 0; i < 1000; ++i)
+        many.push_back(interner.intern("token" + std::to_string(i % 500)));
+
+    // Then
+    ASSERT_EQ(a, 0U);
+    ASSERT_EQ(b, 1U);
+    ASSERT_EQ(again, a);
+    ASSERT_EQ(empty, 2U);
+    ASSERT_EQ(interner.size(), 503U);
+    ASSERT_EQ(interner[b], "beta");
+    ASSERT_EQ(interner[empty], "");
+    ASSERT_EQ(interner[many[742]], "token242");
+    ASSERT_EQ(many[742], many[242]);
+    ASSERT_EQ(interner.find("token499"), std::optional<pypp::Interner::id_type> { 502U });
+    ASSERT_FALSE(interner.contains("token500"));
+    ASSERT_TRUE(interner.pool().starts_with("alphabetatoken0token1"));
+    interner.clear();
+    ASSERT_TRUE(interner.empty());
+    ASSERT_FALSE(interner.find("alpha").has_value());
+    ASSERT_EQ(interner.intern("beta"), 0U);
+}
+
+TEST(InternerTest, GivenText_WhenSplittingIds_ExpectSameCountsAsStrings)
+{
+    // Given
+    const std::string text { "the cat and the dog and the bird" };
+    pypp::Interner interner {};
+
+    // When
+    const auto ids = pypp::splitIds(text, ' ', interner);
+    const collections::IdCounter counts(ids.begin(), ids.end());
+    const auto first_three = pypp::splitIds(text, ' ', interner, 3);
+    std::unordered_set<std::pair<std::uint32_t, std::uint32_t>, collections::TupleHash> bigrams {};
+    for (std::size_t i = 0U; i + 1U < ids.size(); ++i)
+        bigrams.emplace(ids[i], ids[i + 1U]);
+
+    // Then
+    ASSERT_EQ(ids, (std::vector<std::uint32_t> { 0U, 1U, 2U, 0U, 3U, 2U, 0U, 4U }));
+    ASSERT_EQ(first_three, (std::vector<std::uint32_t> { 0U, 1U, 2U }));
+    const auto words = pypp::split(text, ' ');
+    ASSERT_EQ(collections::resolveIds(counts, interner).getUnderlyingMap(),
+        collections::Counter<std::string>(words.begin(), words.end()).getUnderlyingMap());
+    ASSERT_EQ(bigrams.size(), 6U);
+}
+
+TEST(InternerTest, GivenThreads_WhenInterningConcurrently_ExpectOneIdPerString)
+{
+    // Given
+    pypp::ConcurrentInterner interner {};
+    std::vector<std::vector<std::uint32_t>> ids(4U);
+
+    // When
+    std::vector<std::thread> threads {};
+    for (std::size_t t = 0U; t < ids.size(); ++t)
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < 2000; ++i)
+                ids[t].push_back(interner.intern("w" + std::to_string((i * 7 + static_cast<int>(t)) % 300)));
+        });
+    for (auto& thread : threads)
+        thread.join();
+    const auto table = interner.snapshot();
+
+    // Then
+    ASSERT_EQ(interner.size(), 300U);
+    ASSERT_EQ(table.size(), 300U);
+    for (std::size_t t = 0U; t < ids.size(); ++t)
+        for (int i = 0; i < 2000; ++i)
+            ASSERT_EQ(table[ids[t][i]], "w" + std::to_string((i * 7 + static_cast<int>(t)) % 300));
+    ASSERT_EQ(interner.str(*interner.find("w42")), "w42");
+}
+
+TEST(MemoizeTest, GivenRecursiveFunction_WhenMemoizing_ExpectEachStateComputedOnce)
+{
+    // Given
+    auto fib = pypp::memoize<std::uint64_t(int)>(
+        [](auto& self, int n) -> std::uint64_t { return n < 2 ? n : self(n - 1) + self(n - 2); });
+    auto paths = pypp::memoize<std::uint64_t(int, int)>([](auto& self, int rows, int cols) -> std::uint64_t {
+        return rows == 0 || cols == 0 ? 1U : self(rows - 1, cols) + self(rows, cols - 1);
+    });
+
+    // When
+    const auto fib_90 = fib(90);
+    const auto info = fib.cacheInfo();
+    const auto lattice = paths(16, 16);
+
+    // Then
+    ASSERT_EQ(fib_90, 2880067194370816120ULL);
+    ASSERT_EQ(info.misses, 91U);
+    ASSERT_EQ(info.hits, 88U);
+    ASSERT_EQ(info.size, 91U);
+    ASSERT_EQ(info.capacity, 0U);
+    ASSERT_EQ(fib(90), fib_90);
+    ASSERT_EQ(fib.cacheInfo().hits, 89U);
+    ASSERT_EQ(lattice, 601080390U);
+    fib.clear();
+    ASSERT_EQ(fib.cacheInfo().size, 0U);
+    ASSERT_EQ(fib.cacheInfo().hits, 0U);
+}
+
+TEST(MemoizeTest, GivenLruCache_WhenFull_ExpectLeastRecentlyUsedEvicted)
+{
+    // Given
+    int calls { 0 };
+    const auto make_label = [&](const std::string& name, int n) {
+        ++calls;
+        return name + std::to_string(n);
+    };
+    auto label = pypp::lruCache<2U, std::string(const std::string&, int)>(make_label);
+
+    // When
+    label("a", 1);
+    label("b", 2);
+    const auto hit = label("a", 1);
+    label("c", 3); // evicts ("b", 2)
+    const auto calls_before = calls;
+    label("a", 1);
+    label("b", 2); // evicts ("c", 3)
+    label("c", 3); // evicts ("a", 1)
+
+    // Then
+    ASSERT_EQ(hit, "a1");
+    ASSERT_EQ(calls_before, 3);
+    ASSERT_EQ(calls, 5);
+    const auto info = label.cacheInfo();
+    ASSERT_EQ(info.hits, 2U);
+    ASSERT_EQ(info.misses, 5U);
+    ASSERT_EQ(info.size, 2U);
+    ASSERT_EQ(info.capacity, 2U);
+}
+
+TEST(MemoizeTest, GivenLruCache_WhenMovingIntoContainers_ExpectCacheMovedAlong)
+{
+    // Given
+    const auto square = [](int n) { return n * n; };
+    auto cache = pypp::lruCache<2U, int(int)>(square);
+    cache(3);
+    cache(4);
+
+    // When
+    std::vector<decltype(cache)> caches {};
+    caches.push_back(std::move(cache));
+    caches.push_back(pypp::lruCache<2U, int(int)>(square));
+    std::optional<decltype(cache)> later {};
+    later.emplace(std::move(caches.front()));
+    const auto hit = (*later)(3);
+    const auto miss = (*later)(5); // evicts 4
+
+    // Then
+    ASSERT_EQ(hit, 9);
+    ASSERT_EQ(miss, 25);
+    ASSERT_EQ(later->cacheInfo().hits, 1U);
+    ASSERT_EQ(later->cacheInfo().misses, 3U);
+    ASSERT_EQ(later->cacheInfo().size, 2U);
+    ASSERT_EQ(caches.front().cacheInfo().size, 0U);
+    ASSERT_EQ(caches.front()(4), 16);
+    ASSERT_EQ(caches.front().cacheInfo().misses, 1U);
+}
+
 int main(int argc, char** argv)
 {
     testing::InitGoogleTest(&argc, argv);